@@ -0,0 +1,163 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "BrightnessADC.h"
+
+bool BrightnessADCAnalogRead::Begin(const uint8_t& Pin)
+{
+    sensorPin = Pin;
+    pinMode(Pin, INPUT);
+    return true;
+}
+
+bool BrightnessADCAnalogRead::GetReading(uint16_t& Counts, uint16_t& Millivolts)
+{
+    Counts = analogRead(sensorPin);
+    Millivolts = (uint16_t)(((uint32_t)Counts * BRIGHTNESSADC_FULLSCALE_MV) / BRIGHTNESSADC_MAX_COUNTS);
+    return true;
+}
+
+#ifdef ESP32
+int8_t BrightnessADCContinuous::PinToADC1Channel(const uint8_t& Pin)
+{
+    switch (Pin)
+    {
+    case 36: return ADC1_CHANNEL_0;
+    case 37: return ADC1_CHANNEL_1;
+    case 38: return ADC1_CHANNEL_2;
+    case 39: return ADC1_CHANNEL_3;
+    case 32: return ADC1_CHANNEL_4;
+    case 33: return ADC1_CHANNEL_5;
+    case 34: return ADC1_CHANNEL_6;
+    case 35: return ADC1_CHANNEL_7;
+    default: return -1;
+    }
+}
+
+BrightnessADCContinuous::~BrightnessADCContinuous()
+{
+    if (adcChannel != 0xFF)
+    {
+        adc_digi_stop();
+        adc_digi_deinitialize();
+    }
+}
+
+bool BrightnessADCContinuous::Begin(const uint8_t& Pin)
+{
+    int8_t channel = PinToADC1Channel(Pin);
+    if (channel < 0)
+    {
+        //ADC2 can not be used in continuous mode (and not at all while WiFi is on)
+        return false;
+    }
+
+    adc_digi_init_config_t initConfig = {};
+    initConfig.max_store_buf_size = BRIGHTNESSADC_DMA_BUFFER;
+    initConfig.conv_num_each_intr = BRIGHTNESSADC_DMA_FRAME;
+    initConfig.adc1_chan_mask = (uint32_t)1 << channel;
+    initConfig.adc2_chan_mask = 0;
+    if (adc_digi_initialize(&initConfig) != ESP_OK)
+    {
+        return false;
+    }
+
+    adc_digi_pattern_config_t pattern = {};
+    pattern.atten = ADC_ATTEN_DB_11;
+    pattern.channel = (uint8_t)channel;
+    pattern.unit = 0; //ADC1
+    pattern.bit_width = SOC_ADC_DIGI_MAX_BITWIDTH;
+
+    adc_digi_configuration_t digiConfig = {};
+    digiConfig.conv_limit_en = true; //Always on for the ESP32
+    digiConfig.conv_limit_num = 250;
+    digiConfig.pattern_num = 1;
+    digiConfig.adc_pattern = &pattern;
+    digiConfig.sample_freq_hz = BRIGHTNESSADC_SAMPLE_FREQ;
+    digiConfig.conv_mode = ADC_CONV_SINGLE_UNIT_1;
+    digiConfig.format = ADC_DIGI_OUTPUT_FORMAT_TYPE1;
+    if (adc_digi_controller_configure(&digiConfig) != ESP_OK)
+    {
+        adc_digi_deinitialize();
+        return false;
+    }
+
+    esp_adc_cal_characterize(ADC_UNIT_1, ADC_ATTEN_DB_11, ADC_WIDTH_BIT_12, BRIGHTNESSADC_DEFAULT_VREF, &adcCharacteristics);
+    adcChannel = (uint8_t)channel;
+    return true;
+}
+
+bool BrightnessADCContinuous::StartReading()
+{
+    if (adcChannel == 0xFF)
+    {
+        return false;
+    }
+    if (isRunning)
+    {
+        return true;
+    }
+    //adc_digi_stop() leaves the conversions that were not read in the driver buffer, they belong to the previous reading
+    uint8_t buffer[BRIGHTNESSADC_DMA_FRAME];
+    uint32_t length = 0;
+    for (uint8_t frame = 0; frame <= BRIGHTNESSADC_DMA_BUFFER / BRIGHTNESSADC_DMA_FRAME; frame++)
+    {
+        esp_err_t result = adc_digi_read_bytes(buffer, sizeof(buffer), &length, 0);
+        if ((result != ESP_OK && result != ESP_ERR_INVALID_STATE) || length == 0)
+        {
+            break;
+        }
+    }
+    //The DMA only runs while a reading is collected, between readings the ADC is idle
+    sampleSum = 0;
+    sampleCount = 0;
+    isRunning = (adc_digi_start() == ESP_OK);
+    return isRunning;
+}
+
+bool BrightnessADCContinuous::GetReading(uint16_t& Counts, uint16_t& Millivolts)
+{
+    if (!isRunning)
+    {
+        return false;
+    }
+    uint8_t buffer[BRIGHTNESSADC_DMA_FRAME];
+    uint32_t length = 0;
+    //Never waits, the conversions that are not there yet are picked up by the next Process()
+    while (sampleCount < BRIGHTNESSADC_OVERSAMPLE)
+    {
+        esp_err_t result = adc_digi_read_bytes(buffer, sizeof(buffer), &length, 0);
+        //ESP_ERR_INVALID_STATE: the driver buffer was full and conversions were dropped, the data is still valid
+        if ((result != ESP_OK && result != ESP_ERR_INVALID_STATE) || length == 0)
+        {
+            return false;
+        }
+        for (uint32_t i = 0; i + SOC_ADC_DIGI_RESULT_BYTES <= length && sampleCount < BRIGHTNESSADC_OVERSAMPLE; i += SOC_ADC_DIGI_RESULT_BYTES)
+        {
+            adc_digi_output_data_t* data = (adc_digi_output_data_t*)&buffer[i];
+            if (data->type1.channel == adcChannel)
+            {
+                sampleSum += data->type1.data;
+                sampleCount++;
+            }
+        }
+    }
+    adc_digi_stop();
+    isRunning = false;
+
+    uint32_t raw = (sampleSum + sampleCount / 2) / sampleCount;
+    Millivolts = (uint16_t)esp_adc_cal_raw_to_voltage(raw, &adcCharacteristics);
+    uint32_t counts = ((uint32_t)Millivolts * BRIGHTNESSADC_MAX_COUNTS + BRIGHTNESSADC_FULLSCALE_MV / 2) / BRIGHTNESSADC_FULLSCALE_MV;
+    Counts = (uint16_t)(counts > BRIGHTNESSADC_MAX_COUNTS ? BRIGHTNESSADC_MAX_COUNTS : counts);
+    return true;
+}
+#endif
@@ -0,0 +1,91 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// BrightnessADC.h
+
+#ifndef _BRIGHTNESSADC_h
+#define _BRIGHTNESSADC_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#ifdef ESP32
+	#include "driver/adc.h"
+	#include "esp_adc_cal.h"
+#endif
+
+#define BRIGHTNESSADC_MAX_COUNTS 4095
+#define BRIGHTNESSADC_FULLSCALE_MV 3300 //Nominal input range at 11dB attenuation, counts = mV * 4095 / 3300
+#define BRIGHTNESSADC_OVERSAMPLE 512 //Conversions averaged per reading
+#define BRIGHTNESSADC_SAMPLE_FREQ 20000 //Lowest rate of the ESP32 ADC DMA, a reading takes ~26ms
+#define BRIGHTNESSADC_DMA_BUFFER 1024 //Bytes in the driver ring buffer, 2 bytes per conversion
+#define BRIGHTNESSADC_DMA_FRAME 256 //Bytes per DMA interrupt
+#define BRIGHTNESSADC_DEFAULT_VREF 1100 //Used when the eFuse has no Vref calibration
+
+namespace BRIGHTNESSADC_TYPEENUM
+{
+	enum BRIGHTNESSADC_TYPE :uint8_t
+	{
+		BRIGHTNESSADC_TYPE_ANALOGREAD = 0,
+		BRIGHTNESSADC_TYPE_CONTINUOUS = 1,
+	};
+}
+typedef BRIGHTNESSADC_TYPEENUM::BRIGHTNESSADC_TYPE BRIGHTNESSADC_TYPE;
+
+//Source of the light sensor readings. StartReading() begins a reading, false when it could not. GetReading()
+//returns true once it is complete, with the value as counts (0..4095) and in millivolts.
+class BrightnessADC
+{
+public:
+	virtual ~BrightnessADC() {}
+	virtual bool Begin(const uint8_t& Pin) = 0;
+	virtual bool StartReading() { return true; }
+	virtual bool GetReading(uint16_t& Counts, uint16_t& Millivolts) = 0;
+	virtual BRIGHTNESSADC_TYPE GetType() = 0;
+};
+
+//One analogRead() per reading, uncalibrated
+class BrightnessADCAnalogRead : public BrightnessADC
+{
+private:
+	uint8_t sensorPin = 0;
+public:
+	bool Begin(const uint8_t& Pin);
+	bool GetReading(uint16_t& Counts, uint16_t& Millivolts);
+	BRIGHTNESSADC_TYPE GetType() { return BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_ANALOGREAD; }
+};
+
+#ifdef ESP32
+//ADC1 continuous mode: the DMA collects BRIGHTNESSADC_OVERSAMPLE conversions in the background, the average
+//is converted to millivolts with the eFuse calibration. Only ADC1 pins (GPIO 32..39) are supported.
+class BrightnessADCContinuous : public BrightnessADC
+{
+private:
+	uint8_t adcChannel = 0xFF;
+	bool isRunning = false;
+	uint32_t sampleSum = 0;
+	uint16_t sampleCount = 0;
+	esp_adc_cal_characteristics_t adcCharacteristics;
+	static int8_t PinToADC1Channel(const uint8_t& Pin);
+public:
+	~BrightnessADCContinuous();
+	bool Begin(const uint8_t& Pin);
+	bool StartReading();
+	bool GetReading(uint16_t& Counts, uint16_t& Millivolts);
+	BRIGHTNESSADC_TYPE GetType() { return BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS; }
+};
+#endif
+
+#endif
@@ -14,28 +14,58 @@
 
 void BrightnessSensor::Process()
 {
-    if (millis() - previousWeatherInfoCollectMillis >= (BIGHTNESS_UPDATE_INTERVAL))
+    if (!readingPending && millis() - previousWeatherInfoCollectMillis >= (BIGHTNESS_UPDATE_INTERVAL))
     {
         previousWeatherInfoCollectMillis = millis();
-        if (ProcessReading(analogRead(PIN_Sensor)))
+        readingStartMillis = millis();
+        readingPending = sensorADC->StartReading();
+        if (!readingPending)
+        {
+            //The DMA did not start, this and the next readings with analogRead
+            UseAnalogRead();
+            readingPending = sensorADC->StartReading();
+        }
+    }
+    else if (readingPending && millis() - readingStartMillis >= BRIGHTNESS_READING_TIMEOUT)
+    {
+        //The DMA stopped delivering conversions
+        UseAnalogRead();
+        readingPending = sensorADC->StartReading();
+    }
+    uint16_t readingCounts = 0;
+    if (readingPending && sensorADC->GetReading(readingCounts, lastMillivolts))
+    {
+        readingPending = false;
+        if (ProcessReading(readingCounts))
         {
             //Only update once after full loop of all array values
-            uint16_t tBrightnessLightLevel = averageBrightnessLightLevel;
             if (averageBrightnessLightLevel != this->BrightnessLightLevel)
             {
                 this->BrightnessLightLevel = averageBrightnessLightLevel;
-                if (__CB_BRIGHTNESS_CHANGED != NULL)
+                uint16_t tBrightnessLux = luxCalibration.Convert(BrightnessLightLevel);
+                if (tBrightnessLux != BrightnessLux)
                 {
-                    uint16_t B2 = tBrightnessLightLevel + pow((tBrightnessLightLevel / 15), 2);
-                    __CB_BRIGHTNESS_CHANGED(B2);
+                    BrightnessLux = tBrightnessLux;
+                    if (reportPolicy.Update(BrightnessLux) && __CB_BRIGHTNESS_CHANGED != NULL)
+                    {
+                        __CB_BRIGHTNESS_CHANGED(BrightnessLux);
+                    }
                 }
             }
         }
     }
+    float heldLux;
+    if (reportPolicy.Poll(heldLux) && __CB_BRIGHTNESS_CHANGED != NULL)
+    {
+        uint16_t lux = (uint16_t)heldLux;
+        __CB_BRIGHTNESS_CHANGED(lux);
+    }
 }
 
 bool BrightnessSensor::ProcessReading(const unsigned int& Value)
 {
+    // keep the sorted copy of the window for the median and trimmed mean
+    ReplaceSortedReading((uint16_t)readings[readIndex], (uint16_t)Value);
     // subtract the last reading:
     total = total - readings[readIndex];
     // read from the sensor:
@@ -55,7 +85,7 @@ bool BrightnessSensor::ProcessReading(const unsigned int& Value)
     if (readIndex % MODULO_CALC == 0)
     {
         // calculate the average:
-        averageBrightnessLightLevel = total / NUMBER_OF_PROBES;
+        averageBrightnessLightLevel = GetFilteredReading();
         //Serial.print("Probe:"); Serial.print(readIndex); Serial.print(" value:"); Serial.print(averageBrightnessLightLevel);
         return true;
     }
@@ -66,16 +96,113 @@ bool BrightnessSensor::ProcessReading(const unsigned int& Value)
     return false;
 }
 
-BrightnessSensor::BrightnessSensor(const uint8_t& pin)
+void BrightnessSensor::ReplaceSortedReading(const uint16_t& Removed, const uint16_t& Added)
+{
+    //Binary search for the reading that leaves the window, it is always present
+    uint8_t low = 0;
+    uint8_t high = NUMBER_OF_PROBES - 1;
+    while (low < high)
+    {
+        uint8_t mid = (low + high) / 2;
+        if (sortedReadings[mid] < Removed)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    uint8_t position = low;
+    //Move the gap towards the position of the new reading, only the readings in between shift
+    while (position > 0 && sortedReadings[position - 1] > Added)
+    {
+        sortedReadings[position] = sortedReadings[position - 1];
+        position--;
+    }
+    while (position < NUMBER_OF_PROBES - 1 && sortedReadings[position + 1] < Added)
+    {
+        sortedReadings[position] = sortedReadings[position + 1];
+        position++;
+    }
+    sortedReadings[position] = Added;
+}
+
+unsigned int BrightnessSensor::GetFilteredReading()
+{
+    switch (filterType)
+    {
+    case BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_MEDIAN:
+        return ((unsigned int)sortedReadings[(NUMBER_OF_PROBES - 1) / 2] + sortedReadings[NUMBER_OF_PROBES / 2]) / 2;
+    case BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_TRIMMED_MEAN:
+    {
+        unsigned int trimmedTotal = total;
+        for (uint8_t i = 0; i < BRIGHTNESS_TRIM_COUNT; i++)
+        {
+            trimmedTotal -= sortedReadings[i] + sortedReadings[NUMBER_OF_PROBES - 1 - i];
+        }
+        return trimmedTotal / (NUMBER_OF_PROBES - 2 * BRIGHTNESS_TRIM_COUNT);
+    }
+    default:
+        return total / NUMBER_OF_PROBES;
+    }
+}
+
+BrightnessSensor::BrightnessSensor(const uint8_t& pin, const BRIGHTNESSADC_TYPE AdcType)
 {
-    pinMode(pin, INPUT);	
 	this->PIN_Sensor = pin;
     previousWeatherInfoCollectMillis = millis();
+    BrightnessLux = luxCalibration.Convert(BrightnessLightLevel);
+#ifdef ESP32
+    if (AdcType == BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS)
+    {
+        sensorADC = new BrightnessADCContinuous();
+        if (!sensorADC->Begin(pin))
+        {
+            //Fall back to analogRead for pins on ADC2 or when the DMA can not be set up
+            delete sensorADC;
+            sensorADC = NULL;
+        }
+    }
+#endif
+    if (sensorADC == NULL)
+    {
+        sensorADC = new BrightnessADCAnalogRead();
+        sensorADC->Begin(pin);
+    }
+}
+
+void BrightnessSensor::UseAnalogRead()
+{
+    //The continuous driver is released before the pin is read with analogRead
+    delete sensorADC;
+    sensorADC = new BrightnessADCAnalogRead();
+    sensorADC->Begin(PIN_Sensor);
+}
+
+BrightnessSensor::~BrightnessSensor()
+{
+    if (sensorADC != NULL)
+    {
+        delete sensorADC;
+        sensorADC = NULL;
+    }
 }
 
 uint16_t BrightnessSensor::GetBrightness()
 {
-    return BrightnessLightLevel + pow((BrightnessLightLevel / 15), 2);
+    return BrightnessLux;
+}
+
+bool BrightnessSensor::SetLuxCalibration(const char* Calibration)
+{
+    if (!luxCalibration.Parse(Calibration))
+    {
+        return false;
+    }
+    //Reported on the next changed reading
+    BrightnessLux = luxCalibration.Convert(BrightnessLightLevel);
+    return true;
 }
 
 uint16_t BrightnessSensor::GetRawBrightness()
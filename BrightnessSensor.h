@@ -21,30 +21,68 @@
 	#include "WProgram.h"
 #endif
 
+#include "BrightnessADC.h"
+#include "LuxCalibration.h"
+#include "ReportPolicy.h"
+
 #define BIGHTNESS_REFRESH_INTERVAL 30002 // Once every 30 seconds
 #define NUMBER_OF_PROBES 16 //Number of probes for average value calculation (limited to the max value of analogread * PROBECOUNT < 65535 (UINT16))
 #define NUMBER_OF_SLOTS 4
 #define MODULO_CALC (NUMBER_OF_PROBES / NUMBER_OF_SLOTS)
 #define BIGHTNESS_UPDATE_INTERVAL BIGHTNESS_REFRESH_INTERVAL / MODULO_CALC
+#define BRIGHTNESS_READING_TIMEOUT 1000 //ms, a DMA reading takes ~26ms. Not complete by then and the sensor falls back to analogRead
+#define BRIGHTNESS_TRIM_COUNT (NUMBER_OF_PROBES / 4) //Trimmed mean drops this many readings at both ends
+#define BRIGHTNESS_REPORT_POLICY 10, 0.05f, 5, 60000, 1800000 //Station report policy, see ReportPolicy::Configure
+
+namespace BRIGHTNESSFILTER_TYPEENUM
+{
+	enum BRIGHTNESSFILTER_TYPE :uint8_t
+	{
+		BRIGHTNESSFILTER_TYPE_AVERAGE = 0, //Boxcar average over NUMBER_OF_PROBES
+		BRIGHTNESSFILTER_TYPE_MEDIAN = 1,
+		BRIGHTNESSFILTER_TYPE_TRIMMED_MEAN = 2,
+	};
+}
+typedef BRIGHTNESSFILTER_TYPEENUM::BRIGHTNESSFILTER_TYPE BRIGHTNESSFILTER_TYPE;
 
 
 class BrightnessSensor {
 public:
 	void Process();	
-	BrightnessSensor(const uint8_t& pin);
+	BrightnessSensor(const uint8_t& pin, const BRIGHTNESSADC_TYPE AdcType = BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_ANALOGREAD);
+	~BrightnessSensor();
 	void SetOnLuxValueChangeEvent(void(*callback)(const uint16_t& Luxvalue)) { __CB_BRIGHTNESS_CHANGED = callback; }
 	uint16_t GetBrightness();
 	uint16_t GetRawBrightness();
+	uint16_t GetMillivolts() { return lastMillivolts; } //Last single reading
+	BRIGHTNESSADC_TYPE GetAdcType() { return sensorADC->GetType(); }
+	void SetFilter(const BRIGHTNESSFILTER_TYPE& Filter) { filterType = Filter; }
+	BRIGHTNESSFILTER_TYPE GetFilter() { return filterType; }
+	bool SetLuxCalibration(const char* Calibration);
+	String GetLuxCalibration() { return luxCalibration.ToString(); }
+	ReportPolicy& GetReportPolicy() { return reportPolicy; }
 private:
 	void(*__CB_BRIGHTNESS_CHANGED)(const uint16_t& Luxvalue) = NULL;
 	unsigned long previousWeatherInfoCollectMillis = 0;
 	uint8_t PIN_Sensor;
+	BrightnessADC* sensorADC = NULL;
+	bool readingPending = false;
+	unsigned long readingStartMillis = 0;
+	uint16_t lastMillivolts = 0;
 	uint16_t BrightnessLightLevel = 0xFFFF;
+	uint16_t BrightnessLux = 0; //BrightnessLightLevel converted once per reading
+	LuxCalibration luxCalibration;
+	ReportPolicy reportPolicy;
 	unsigned int readings[NUMBER_OF_PROBES] = { 0 };  // the readings from the analog input
 	unsigned int readIndex = 0;          // the index of the current reading
 	unsigned int total = 0;              // the running total
 	unsigned int averageBrightnessLightLevel = 0;            // the average
+	uint16_t sortedReadings[NUMBER_OF_PROBES] = { 0 }; // the same readings in ascending order
+	BRIGHTNESSFILTER_TYPE filterType = BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_AVERAGE;
 	bool ProcessReading(const unsigned int& Value);
+	void UseAnalogRead();
+	void ReplaceSortedReading(const uint16_t& Removed, const uint16_t& Added);
+	unsigned int GetFilteredReading();
 };
 
 #endif
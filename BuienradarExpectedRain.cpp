@@ -3,7 +3,7 @@
 * Title			    : FreeAtHome_ESPWeatherStation
 * Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
 * Version		    : v 0.9
-* Last updated      : 2023.12.11
+* Last updated      : 2026.10.17
 * Target		    : Custom build Weather Station
 * Author            : Roeland Kluit
 * Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
@@ -12,6 +12,8 @@
 **************************************************************************************************************/
 #include "BuienradarExpectedRain.h"
 #include "BuienradarHTTPClient.h"
+#include "ConversionTables.h"
+#include "RainTextParser.h"
 
 Buienradar::~Buienradar()
 {
@@ -26,6 +28,7 @@ Buienradar::Buienradar(const String Latitude, const String Longitude)
     this->strLongitude = FixDecimalCount(Longitude);
     this->strLatitude = FixDecimalCount(Latitude);
     BuienradarRequest = new BuienradarHTTPClient();
+    retryPolicy.Configure(BUIENRADAR_RETRY_POLICY);
     previousRefreshMillis = millis();
 }
 
@@ -64,21 +67,25 @@ void Buienradar::ScheduleNextUpdate(const bool& lastUpdateSuccesfull)
     previousRefreshMillis = millis();
     if (!lastUpdateSuccesfull)
     {
-        MillisTimeWaitTime = 30000; //30 seconden retry     
+        //Backs off, after too many failures in a row only a trial request is made every open interval
+        MillisTimeWaitTime = retryPolicy.OnFailure();
+        return;
     }
-    else if (isLowRefreshMode)
+
+    retryPolicy.OnSuccess();
+    if (isLowRefreshMode)
     {
-        MillisTimeWaitTime = 30 * 60000; //60 seconden * 30 minuten
+        MillisTimeWaitTime = BUIENRADAR_POLL_NIGHT_MS;
     }
     else
     {
-        if (isRainOrExpectedRain)
+        MillisTimeWaitTime = GetForecastPollInterval();
+        //Polling before max-age ends fetches the same forecast again
+        unsigned long maxAge = BuienradarRequest->GetMaxAgeMillis();
+        maxAge = maxAge > BUIENRADAR_POLL_STABLE_MS ? BUIENRADAR_POLL_STABLE_MS : maxAge;
+        if (MillisTimeWaitTime < maxAge)
         {
-            MillisTimeWaitTime = 5 * 60000; //60 seconden * 5 minuten
-        }
-        else
-        {
-            MillisTimeWaitTime = 15 * 60000; //60 seconden * 15 minuten
+            MillisTimeWaitTime = maxAge;
         }
     }
     /*
@@ -88,6 +95,26 @@ void Buienradar::ScheduleNextUpdate(const bool& lastUpdateSuccesfull)
     */
 }
 
+unsigned long Buienradar::GetForecastPollInterval()
+{
+    int16_t minutesToRain = forecast.GetMinutesToRain();
+    bool isDry = minutesToRain == RAINFORECAST_NONE;
+    bool isStable = isDry && wasForecastDry;
+    wasForecastDry = isDry;
+
+    if (isDry)
+    {
+        return isStable ? BUIENRADAR_POLL_STABLE_MS : BUIENRADAR_POLL_CHANGED_MS;
+    }
+    //Halve the time to the predicted onset every poll, so the onset is followed closer as it comes near
+    unsigned long interval = (unsigned long)(minutesToRain / 2) * 60000UL;
+    if (interval < BUIENRADAR_POLL_RAIN_MS)
+    {
+        return BUIENRADAR_POLL_RAIN_MS;
+    }
+    return interval > BUIENRADAR_POLL_CHANGED_MS ? BUIENRADAR_POLL_CHANGED_MS : interval;
+}
+
 unsigned long Buienradar::GetWaitTime()
 {
     return (MillisTimeWaitTime / 1000);
@@ -98,6 +125,16 @@ long Buienradar::GetRefreshSecondsRemaining()
     return ((long(millis() - previousRefreshMillis) + long(MillisTimeWaitTime)) / 1000);
 }
 
+String Buienradar::GetConnectionStats()
+{
+    return BuienradarRequest->GetConnectionStats();
+}
+
+String Buienradar::GetLastBodyData()
+{
+    return "[" + BuienradarRequest->GetRainText().GetDiagnostics() + "]";
+}
+
 bool Buienradar::GetLastRequestSucceeded()
 {
     return this->lastRequestSucceeded;
@@ -110,6 +147,8 @@ void Buienradar::SetRainExpected(const bool &isRainOrExpected, const float &amou
     {
         //Serial.print("Change of rain expected: "); Serial.println(isRainOrExpected);
         isRainOrExpectedRain = isRainOrExpected;
+        //Rain or no rain is always reported, only the amount has a deadband
+        reportPolicy.Reset();
         isChanged = true;
     }
     if (amountOfRain != amount)
@@ -119,7 +158,7 @@ void Buienradar::SetRainExpected(const bool &isRainOrExpected, const float &amou
         isChanged = true;
     }
 
-    if (isChanged && __CB_RAIN_EXPECTED_CHANGED != NULL)
+    if (isChanged && reportPolicy.Update(amount) && __CB_RAIN_EXPECTED_CHANGED != NULL)
     {
         __CB_RAIN_EXPECTED_CHANGED(isRainOrExpected, amount);
     }
@@ -146,14 +185,20 @@ void Buienradar::Process()
     else if (BuienradarRequest->GetAsyncStatus() == HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS)
     {
         //Serial.println("Completed");
-        String BodyData = BuienradarRequest->GetBody();
-        this->LastBodyData = "[" + BodyData + "]";
-        if (ParseBuienradarData(BodyData))
+        if (BuienradarRequest->IsNotModified())
+        {
+            //The server has no newer forecast, the current one is kept
+            lastRequestSucceeded = true;
+        }
+        else if (ParseBuienradarData(BuienradarRequest->GetRainText()))
         {
+            forecast.Update(BuienradarRequest->GetRainText());
             lastRequestSucceeded = true;
         }
         else
         {
+            //Do not let the server confirm a payload that could not be used
+            BuienradarRequest->ClearValidators();
             lastRequestSucceeded = false;
         }
         //Serial.println(returndata);
@@ -167,13 +212,15 @@ void Buienradar::Process()
         #endif // DEBUG
 
         String URI = String(F("/data/raintext/?lat=")) + strLatitude + String(F("&lon=")) + strLongitude;
+        retryPolicy.OnAttempt();
         if (BuienradarRequest->HTTPRequestAsync("gpsgadget.buienradar.nl", 443, URI))
         {
             #ifdef DEBUG
                 Serial.println(String(F("requested")));
             #endif // DEBUG
-            //ASync started, reset counter
-            ScheduleNextUpdate(false);
+            //ASync started, reset counter. The session timeout ends the request, this is not a failure (yet)
+            previousRefreshMillis = millis();
+            MillisTimeWaitTime = BUIENRADAR_POLL_PENDING_MS;
         }
         else
         {
@@ -183,6 +230,12 @@ void Buienradar::Process()
             ScheduleNextUpdate(false);
         }
     }
+
+    float heldAmount;
+    if (reportPolicy.Poll(heldAmount) && __CB_RAIN_EXPECTED_CHANGED != NULL)
+    {
+        __CB_RAIN_EXPECTED_CHANGED(isRainOrExpectedRain, heldAmount);
+    }
 }
 
 void Buienradar::CalculateForcastSampleSize()
@@ -213,9 +266,10 @@ void Buienradar::CalculateForcastSampleSize()
     //Serial.print("Numbr of Lines to check: "); Serial.println(maxForcastLinesToCheck);
 }
 
-bool Buienradar::ParseBuienradarData(const String &regendata)
+bool Buienradar::ParseBuienradarData(const RainTextParser &regendata)
 {
-    if (regendata.length() < 20)
+    //A 200 with something else than raintext, an HTML error page or a captive portal, is not a dry forecast
+    if (regendata.GetByteCount() < 20 || !regendata.IsValid() || regendata.GetSampleCount() == 0)
     {
         //Serial.println("Invalid data");
         return false;
@@ -225,25 +279,10 @@ bool Buienradar::ParseBuienradarData(const String &regendata)
 
     float ldCurrentAmountOfRain = 0;
     bool blRainExpectedOrRaining = false;
-    uint lineCount = 0;
 
-    int startPos = 0;
-    while (startPos >= 0)
+    for (uint8_t lineCount = 0; lineCount < regendata.GetSampleCount(); lineCount++)
     {
-        int endPos = regendata.indexOf("\n", startPos);
-        if (endPos < 0)
-        {
-            //Serial.println(F("NoMoreEndlines"));
-            break;
-        }
-
-        int sliderPos = regendata.indexOf("|", startPos);
-        if (sliderPos < 0)
-        {
-            //Serial.println(F("InvalidSliderPos"));
-            break;
-        }
-        float val = regendata.substring(startPos, sliderPos).toInt();
+        uint16_t val = regendata.GetSample(lineCount).intensity;
 
         if (val > 0)
         {
@@ -254,22 +293,19 @@ bool Buienradar::ParseBuienradarData(const String &regendata)
 
             if (lineCount == 0) //Use the value for the first upcomming messurement
             {
-                ldCurrentAmountOfRain = pow(10, ((val - 109) / 32));
+                ldCurrentAmountOfRain = ConversionTables::RainAmount((int)val);
             }
             //We have rain detected, no need to look for more records
             break;
         }
         //Serial.print('~'); Serial.print(val);
 
-        startPos = endPos + 1;
-
         if (lineCount != 0 && lineCount >= maxForcastLinesToCheck)
         {
             break;
         }
-        lineCount++;
     }
     //Serial.println();
     SetRainExpected(blRainExpectedOrRaining, ldCurrentAmountOfRain);
     return true;
-}
\ No newline at end of file
+}
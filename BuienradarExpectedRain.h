@@ -3,7 +3,7 @@
 * Title			    : FreeAtHome_ESPWeatherStation
 * Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
 * Version		    : v 0.9
-* Last updated      : 2023.12.11
+* Last updated      : 2026.10.17
 * Target		    : Custom build Weather Station
 * Author            : Roeland Kluit
 * Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
@@ -20,9 +20,22 @@
 #else
 	#include "WProgram.h"
 #endif
+
+#include "ReportPolicy.h"
+#include "RainForecast.h"
+#include "RetryPolicy.h"
+
 #define MAX_TIME_SEGEMENTS_TO_USE_FOR_RAIN_FORECAST	3
+#define BUIENRADAR_POLL_PENDING_MS 30000 //Shown while a request is pending, HTTP_SESSION_TIMEOUT_MS ends it
+#define BUIENRADAR_RETRY_POLICY 30000, 15 * 60000UL, 0.25f, 6, 30 * 60000UL //Backoff 30 s..15 min, circuit opens for 30 min after 6 failures, see RetryPolicy::Configure
+#define BUIENRADAR_POLL_NIGHT_MS (30 * 60000UL)
+#define BUIENRADAR_POLL_RAIN_MS (5 * 60000UL) //Raining now, the nowcast is refreshed every 5 minutes
+#define BUIENRADAR_POLL_CHANGED_MS (15 * 60000UL) //Dry, but the previous forecast was not
+#define BUIENRADAR_POLL_STABLE_MS (30 * 60000UL) //Dry for two forecasts in a row
+#define BUIENRADAR_REPORT_POLICY 0.05f, 0.1f, 0, 0, 0 //Station report policy for the amount, see ReportPolicy::Configure
 
 class BuienradarHTTPClient;
+class RainTextParser;
 
 class Buienradar
 {
@@ -36,7 +49,7 @@ private:
 	bool isRainOrExpectedRain = false;
 	float amountOfRain = -1; //Set to invalid value to force update first poll
 	uint8_t maxForcastLinesToCheck = MAX_TIME_SEGEMENTS_TO_USE_FOR_RAIN_FORECAST;
-	bool ParseBuienradarData(const String &regendata);
+	bool ParseBuienradarData(const RainTextParser &regendata);
 	void ScheduleNextUpdate(const bool &lastUpdateSuccesfull);	
 	//void ProcessInternal();
 	void SetRainExpected(const bool& isRainOrExpected, const float& amount);
@@ -45,6 +58,11 @@ private:
 	String FixDecimalCount(const String& input);
 	void(*__CB_RAIN_EXPECTED_CHANGED)(const bool &isRainOrExpected, const float &amount) = NULL;
 	bool lastRequestSucceeded = false;
+	ReportPolicy reportPolicy; //Amount of rain, a change of rain or no rain is always reported
+	RainForecast forecast;
+	RetryPolicy retryPolicy; //Failed polls
+	bool wasForecastDry = false;
+	unsigned long GetForecastPollInterval();
 public:
 	void SetOnRainReportEvent(void(*callback)(const bool& isRainOrExpected, const float& amount)) { __CB_RAIN_EXPECTED_CHANGED = callback; }
 	~Buienradar();
@@ -55,7 +73,11 @@ public:
 	long GetRefreshSecondsRemaining();
 	bool GetLastRequestSucceeded();
 	void Process();	
-	String LastBodyData = "";
+	String GetLastBodyData(); //Tail of the last received payload, for diagnostics
+	String GetConnectionStats(); //TLS handshake time and heap peak of the last poll
+	ReportPolicy& GetReportPolicy() { return reportPolicy; }
+	const RainForecast& GetForecast() { return forecast; }
+	RetryPolicy& GetRetryPolicy() { return retryPolicy; }
 };
 
 #endif
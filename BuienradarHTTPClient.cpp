@@ -28,6 +28,30 @@ void BuienradarHTTPClient::ReleaseAsync()
 	AsyncStatus = HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_NONE;	
 }
 
+void BuienradarHTTPClient::ClearValidators()
+{
+	eTag = "";
+	lastModified = "";
+	responseDate = "";
+}
+
+void BuienradarHTTPClient::SampleFreeHeap()
+{
+	uint32_t freeHeap = ESP.getFreeHeap();
+	if (freeHeap < pollFreeHeapMin)
+	{
+		pollFreeHeapMin = freeHeap;
+	}
+}
+
+String BuienradarHTTPClient::GetConnectionStats()
+{
+	String Stats = String(lastHandshakeMillis) + String(F(" ms connect, heap peak ")) + String(GetPollHeapPeak());
+	Stats += String(F(", connects ")) + String(connectCount);
+	Stats += String(F(", not modified ")) + String(notModifiedCount) + String(F(", max-age ")) + String(maxAgeMs / 1000);
+	return Stats;
+}
+
 BuienradarHTTPClient::BuienradarHTTPClient() :HTTPClient(true)
 {
 }
@@ -36,7 +60,13 @@ bool BuienradarHTTPClient::ConnectToHost(const String &HTTPHost, const int &port
 {
 	if (this->GetState() <= HTTPCLIENT_STATE::HTTPCLIENT_STATE_CLOSED)
 	{
-		if (!this->Connect(HTTPHost.c_str(), port))
+		//By name, not through the DNS cache: the TLS server name and the certificate host check take the name that is
+		//connected to, the HTTPClient has no connect by address with a separate server name. Includes the name resolution.
+		unsigned long handshakeStart = millis();
+		bool isConnected = this->Connect(HTTPHost.c_str(), port);
+		lastHandshakeMillis = millis() - handshakeStart;
+
+		if (!isConnected)
 		{
 			this->abort();
 			return false;
@@ -53,13 +83,21 @@ bool BuienradarHTTPClient::HTTPRequestAsync(const String &HostName, const int &p
 {
 	if (AsyncStatus != HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING)
 	{
+		pollFreeHeapStart = ESP.getFreeHeap();
+		pollFreeHeapMin = pollFreeHeapStart;
 		if (!ConnectToHost(HostName, port))
 		{
 			DEBUG_PL(F("Failed to Connect"));
 			return false;
 		}
+		connectCount++;
+		SampleFreeHeap();
+		maxAgeMs = 0;
+		isNotModified = false;
+		contentLength = -1;
 		ConnectedHostName = HostName;
 		Async_URI = URI;
+		rainText.Reset();
 		AsyncStatus = HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING;
 	}
 	return true;
@@ -68,6 +106,7 @@ bool BuienradarHTTPClient::HTTPRequestAsync(const String &HostName, const int &p
 void BuienradarHTTPClient::ProcessAsync()
 {
 	HTTPREQUEST_STATUS reqStatus;
+	SampleFreeHeap();
 
 	switch (this->GetState())
 	{
@@ -75,7 +114,12 @@ void BuienradarHTTPClient::ProcessAsync()
 		case HTTPCLIENT_STATE::HTTPCLIENT_STATE_CLOSED:
 			if (AsyncStatus == HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING)
 			{
-				//Todo Check payload (getBody) size?
+				if (contentLength < 0 && !isNotModified)
+				{
+					//Collected by the HTTPClient until the server closed the connection
+					String body = this->GetBody();
+					rainText.Feed((const uint8_t*)body.c_str(), body.length());
+				}
 				AsyncStatus = HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS;
 			}
 			return;
@@ -145,6 +189,19 @@ bool BuienradarHTTPClient::PutHTTPRequest(const String& Host, const String& URI)
 		//this->AddRequestHeader(String(F("Content-Type")), appjson);
 		//this->AddRequestHeader(String(F("Accept")), appjson);
 		this->AddRequestHeader(String(F("Host")), Host);
+		if (eTag.length() > 0)
+		{
+			this->AddRequestHeader(String(F("If-None-Match")), eTag);
+		}
+		//Without a Last-Modified the Date of the last response is the time of the data we have
+		if (lastModified.length() > 0)
+		{
+			this->AddRequestHeader(String(F("If-Modified-Since")), lastModified);
+		}
+		else if (responseDate.length() > 0)
+		{
+			this->AddRequestHeader(String(F("If-Modified-Since")), responseDate);
+		}
 
 		if (!this->Request(String(F("GET")), URI, ""))
 		{
@@ -168,6 +225,34 @@ HTTPREQUEST_STATUS BuienradarHTTPClient::ProcessHTTPHeaders()
 		if (this->ReadHeaders(Key, Value))
 		{
 			//DEBUG_P("hdr: "); DEBUG_P(Key);	DEBUG_P("-->"); DEBUG_PL(Value);
+			if (Key.equalsIgnoreCase(F("Content-Length")))
+			{
+				contentLength = Value.toInt();
+			}
+			else if (Key.equalsIgnoreCase(F("ETag")))
+			{
+				eTag = Value;
+			}
+			else if (Key.equalsIgnoreCase(F("Last-Modified")))
+			{
+				lastModified = Value;
+			}
+			else if (Key.equalsIgnoreCase(F("Date")))
+			{
+				responseDate = Value;
+			}
+			else if (Key.equalsIgnoreCase(F("Cache-Control")))
+			{
+				int maxAgePos = Value.indexOf(F("max-age="));
+				if (Value.indexOf(F("no-cache")) >= 0 || Value.indexOf(F("no-store")) >= 0)
+				{
+					maxAgeMs = 0;
+				}
+				else if (maxAgePos >= 0)
+				{
+					maxAgeMs = (unsigned long)Value.substring(maxAgePos + 8).toInt() * 1000;
+				}
+			}
 			return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING;
 		}
 		else
@@ -182,7 +267,31 @@ HTTPREQUEST_STATUS BuienradarHTTPClient::ProcessHTTPBody()
 {
 	if (this->GetState() == HTTPCLIENT_STATE::HTTPCLIENT_STATE_DATA)
 	{
-		this->ReadPayload();
+		if (isNotModified)
+		{
+			//A 304 has no body
+			return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS;
+		}
+		if (contentLength < 0)
+		{
+			//No length to tell where the body ends, the HTTPClient collects it until the server closes the connection
+			this->ReadPayload();
+			return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING;
+		}
+
+		//Read from the connection, only what has arrived so the read does not wait for the stream timeout
+		Stream* stream = this->GetStreamPtr();
+		int available = stream->available();
+		if (available > 0)
+		{
+			uint8_t chunk[BUIENRADARHTTP_READ_CHUNK];
+			size_t length = stream->readBytes(chunk, available < (int)sizeof(chunk) ? (size_t)available : sizeof(chunk));
+			rainText.Feed(chunk, length);
+		}
+		if ((long)rainText.GetByteCount() >= contentLength)
+		{
+			return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS;
+		}
 		return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING;
 	}
 
@@ -200,7 +309,14 @@ HTTPREQUEST_STATUS BuienradarHTTPClient::GetHTTPRequestResult()
 		uint16_t resultcode = 0xFFFF;
 		if (this->ReadResult(&resultcode))
 		{
-			if (resultcode != 200)
+			if (resultcode == 304)
+			{
+				//Not modified, the validators of the last response stay valid unless the headers replace them
+				isNotModified = true;
+				notModifiedCount++;
+				return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS;
+			}
+			else if (resultcode != 200)
 			{
 				DEBUG_P(F("HTTP_CLIENT_FAILED: HTTP_STATUS_"));
 				DEBUG_PL(resultcode);
@@ -209,6 +325,8 @@ HTTPREQUEST_STATUS BuienradarHTTPClient::GetHTTPRequestResult()
 			}
 			else
 			{
+				//New data, only the validators of this response apply to it
+				ClearValidators();
 				return HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS;
 			}
 		}
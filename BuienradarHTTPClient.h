@@ -12,6 +12,9 @@
 **************************************************************************************************************/
 #pragma once
 #include "HTTPClient.h"
+#include "RainTextParser.h"
+
+#define BUIENRADARHTTP_READ_CHUNK 64 //Payload bytes read per ProcessAsync() call, on the stack
 
 namespace HTTPREQUEST_STATUSUS
 {
@@ -39,12 +42,32 @@ private:
 	//String Async_PostData;
 	//String Async_Method;
 	HTTPREQUEST_STATUS AsyncStatus = HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_NONE;
+	RainTextParser rainText; //The payload is parsed while it arrives instead of collected in the body
+	long contentLength = -1; //Content-Length of the response, -1 when the server did not send it
+	unsigned long lastHandshakeMillis = 0;
+	uint32_t pollFreeHeapStart = 0;
+	uint32_t pollFreeHeapMin = 0;
+	uint32_t connectCount = 0;
+	String eTag; //Validators of the last response, sent back to get a 304 when the data did not change
+	String lastModified;
+	String responseDate;
+	unsigned long maxAgeMs = 0;
+	bool isNotModified = false;
+	uint32_t notModifiedCount = 0;
+	void SampleFreeHeap();
 public:
 	HTTPREQUEST_STATUS GetAsyncStatus();
 	BuienradarHTTPClient();
 	bool HTTPRequestAsync(const String& HostName, const int& port, const String& URI);
 	void ProcessAsync();
 	void ReleaseAsync();
+	const RainTextParser& GetRainText() { return rainText; }
+	bool IsNotModified() { return isNotModified; } //The last request got a 304, there is no payload
+	unsigned long GetMaxAgeMillis() { return maxAgeMs; } //Cache-Control max-age of the last response, 0 when absent
+	void ClearValidators(); //The next request is unconditional, call when the last payload was not usable
+	unsigned long GetLastHandshakeMillis() { return lastHandshakeMillis; } //Connect() of the last poll, includes the TLS handshake
+	uint32_t GetPollHeapPeak() { return pollFreeHeapStart > pollFreeHeapMin ? pollFreeHeapStart - pollFreeHeapMin : 0; } //Bytes, sampled during the last poll
+	String GetConnectionStats();
 	//bool HTTPRequest(const String& URI, const String& Method, const String& PostData);
 	~BuienradarHTTPClient();
 };
\ No newline at end of file
@@ -0,0 +1,137 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "ConversionTables.h"
+
+//Compile time math, written as single expression constexpr functions so it also builds as C++11
+namespace
+{
+    constexpr double CONST_LN2 = 0.693147180559945309417;
+    constexpr double CONST_LN10 = 2.302585092994045684018;
+
+    constexpr double ConstAbs(const double x)
+    {
+        return x < 0 ? -x : x;
+    }
+
+    //Taylor series, only used for |x| <= 0.5
+    constexpr double ConstExpSeries(const double x, const double term, const int n)
+    {
+        return (n > 30) ? term : term + ConstExpSeries(x, term * x / n, n + 1);
+    }
+
+    constexpr double ConstExp(const double x)
+    {
+        return (ConstAbs(x) > 0.5) ? ConstExp(x / 2) * ConstExp(x / 2) : ConstExpSeries(x, 1.0, 1);
+    }
+
+    //ln(m) = 2 * atanh((m - 1) / (m + 1)) for m in 1..2
+    constexpr double ConstAtanhSeries(const double z2, const double power, const int n)
+    {
+        return (n > 61) ? 0 : power / n + ConstAtanhSeries(z2, power * z2, n + 2);
+    }
+
+    constexpr double ConstLn(const double x)
+    {
+        return (x > 2) ? ConstLn(x / 2) + CONST_LN2 :
+            (x < 1) ? ConstLn(x * 2) - CONST_LN2 :
+            2 * ConstAtanhSeries(((x - 1) / (x + 1)) * ((x - 1) / (x + 1)), (x - 1) / (x + 1), 1);
+    }
+
+    //Index list to expand a table initializer, std::index_sequence is C++14
+    template <int... I> struct IndexList {};
+    template <int N, int... I> struct MakeIndexList : MakeIndexList<N - 1, N - 1, I...> {};
+    template <int... I> struct MakeIndexList<0, I...> { typedef IndexList<I...> type; };
+
+    template <typename T, int N> struct Table
+    {
+        T values[N];
+    };
+
+    //pow(pow(y, 0.33), 2) >= b  <=>  y >= b ^ (1 / 0.66), with y = ms / 0.836
+    constexpr double BeaufortThresholdMs(const int b)
+    {
+        return 0.836 * ConstExp(ConstLn((double)b) / 0.66);
+    }
+
+    template <int... I> constexpr Table<double, sizeof...(I)> BuildBeaufortTable(IndexList<I...>)
+    {
+        return { { BeaufortThresholdMs(I + 1)... } };
+    }
+
+    constexpr float RainAmountMmH(const int v)
+    {
+        return (float)ConstExp(CONST_LN10 * ((double)(v - 109) / 32));
+    }
+
+    template <int... I> constexpr Table<float, sizeof...(I)> BuildRainTable(IndexList<I...>)
+    {
+        return { { RainAmountMmH(I)... } };
+    }
+
+    constexpr Table<double, CONVERSION_BEAUFORT_TABLE_SIZE> BeaufortTable = BuildBeaufortTable(MakeIndexList<CONVERSION_BEAUFORT_TABLE_SIZE>::type());
+    constexpr Table<float, CONVERSION_RAIN_TABLE_SIZE> RainTable = BuildRainTable(MakeIndexList<CONVERSION_RAIN_TABLE_SIZE>::type());
+}
+
+namespace ConversionTables
+{
+    uint8_t Beaufort(const float& Speed)
+    {
+        double speed = Speed;
+        if (!(speed < BeaufortTable.values[CONVERSION_BEAUFORT_TABLE_SIZE - 1]))
+        {
+            //Beyond the table (or NaN), keep the original formula
+            return pow(pow((Speed / 0.836), 0.33), 2);
+        }
+        //Number of thresholds at or below the speed
+        uint8_t low = 0;
+        uint8_t high = CONVERSION_BEAUFORT_TABLE_SIZE - 1;
+        while (low < high)
+        {
+            uint8_t mid = (low + high) / 2;
+            if (speed >= BeaufortTable.values[mid])
+            {
+                low = mid + 1;
+            }
+            else
+            {
+                high = mid;
+            }
+        }
+        return low;
+    }
+
+    uint16_t Lux(const uint16_t& Raw)
+    {
+        //Raw / 15 is an integer division, so the square is exact in integer math
+        uint32_t r15 = Raw / 15;
+        return (uint16_t)(Raw + r15 * r15);
+    }
+
+    float RainAmount(const int& Intensity)
+    {
+        if (Intensity < 0 || Intensity >= CONVERSION_RAIN_TABLE_SIZE)
+        {
+            return pow(10, (((float)Intensity - 109) / 32));
+        }
+        return RainTable.values[Intensity];
+    }
+
+    double BeaufortThreshold(const uint8_t& Beaufort)
+    {
+        if (Beaufort == 0 || Beaufort > CONVERSION_BEAUFORT_TABLE_SIZE)
+        {
+            return 0;
+        }
+        return BeaufortTable.values[Beaufort - 1];
+    }
+}
@@ -0,0 +1,39 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// ConversionTables.h
+
+#ifndef _CONVERSIONTABLES_h
+#define _CONVERSIONTABLES_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define CONVERSION_BEAUFORT_TABLE_SIZE 32 //Thresholds for Beaufort 1..32, faster wind falls back to the formula
+#define CONVERSION_RAIN_TABLE_SIZE 256 //Buienradar intensity is 0..255
+
+//Conversions without libm calls at runtime. The tables are generated at compile time and give the same
+//results as the formulas they replace: Beaufort = (uint8_t)pow(pow(ms / 0.836, 0.33), 2),
+//lux = raw + pow(raw / 15, 2) and rain mm/h = pow(10, (intensity - 109) / 32).
+namespace ConversionTables
+{
+	uint8_t Beaufort(const float& Speed);
+	uint16_t Lux(const uint16_t& Raw);
+	float RainAmount(const int& Intensity);
+	//Lowest wind speed in m/s that gives the Beaufort number, 1..CONVERSION_BEAUFORT_TABLE_SIZE
+	double BeaufortThreshold(const uint8_t& Beaufort);
+}
+
+#endif
@@ -0,0 +1,225 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "DerivedWeather.h"
+
+#define INPUT_BIT(input) (1 << DERIVEDWEATHER_INPUT::input)
+#define QUANTITY_BIT(quantity) (1 << DERIVEDWEATHER_QUANTITY::quantity)
+
+//Quantities that are recomputed when the input changes
+static const uint8_t dependentQuantities[DERIVEDWEATHER_INPUT_COUNT] =
+{
+    QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_WINDCHILL) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_DEWPOINT) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_HEATINDEX) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_FEELSLIKE),
+    QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_WINDCHILL) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_FEELSLIKE),
+    QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_DEWPOINT) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_HEATINDEX) | QUANTITY_BIT(DERIVEDWEATHER_QUANTITY_FEELSLIKE),
+};
+
+//Inputs a quantity can not be computed without
+static const uint8_t requiredInputs[DERIVEDWEATHER_QUANTITY_COUNT] =
+{
+    INPUT_BIT(DERIVEDWEATHER_INPUT_TEMPERATURE) | INPUT_BIT(DERIVEDWEATHER_INPUT_WINDSPEED),
+    INPUT_BIT(DERIVEDWEATHER_INPUT_TEMPERATURE) | INPUT_BIT(DERIVEDWEATHER_INPUT_HUMIDITY),
+    INPUT_BIT(DERIVEDWEATHER_INPUT_TEMPERATURE) | INPUT_BIT(DERIVEDWEATHER_INPUT_HUMIDITY),
+    INPUT_BIT(DERIVEDWEATHER_INPUT_TEMPERATURE),
+};
+
+static const char* quantityNames[DERIVEDWEATHER_QUANTITY_COUNT] = { "WindChill", "DewPoint", "HeatIndex", "FeelsLike" };
+
+DerivedWeather::DerivedWeather()
+{
+    for (uint8_t i = 0; i < DERIVEDWEATHER_INPUT_COUNT; i++)
+    {
+        inputs[i] = 0;
+    }
+    for (uint8_t q = 0; q < DERIVEDWEATHER_QUANTITY_COUNT; q++)
+    {
+        values[q] = NAN;
+        computeCount[q] = 0;
+    }
+}
+
+void DerivedWeather::SetInput(const DERIVEDWEATHER_INPUT& Input, const float& Value)
+{
+    if (Input >= DERIVEDWEATHER_INPUT_COUNT || isnan(Value))
+    {
+        return;
+    }
+    if ((knownInputs & (1 << Input)) && inputs[Input] == Value)
+    {
+        //Unchanged, nothing to recompute
+        return;
+    }
+    inputs[Input] = Value;
+    knownInputs |= (1 << Input);
+    dirtyQuantities |= dependentQuantities[Input];
+}
+
+void DerivedWeather::Process()
+{
+    //Several inputs that changed since the previous call cost one computation per quantity
+    if (dirtyQuantities != 0)
+    {
+        uint8_t dirty = dirtyQuantities;
+        dirtyQuantities = 0;
+        for (uint8_t q = 0; q < DERIVEDWEATHER_QUANTITY_COUNT; q++)
+        {
+            if (!(dirty & (1 << q)) || (knownInputs & requiredInputs[q]) != requiredInputs[q])
+            {
+                continue;
+            }
+            float value;
+            bool isAvailable = Compute((DERIVEDWEATHER_QUANTITY)q, value);
+            computeCount[q]++;
+            if (!isAvailable)
+            {
+                continue;
+            }
+            availableQuantities |= (1 << q);
+            if (value != values[q])
+            {
+                values[q] = value;
+                if (reportPolicies[q].Update(value))
+                {
+                    Report((DERIVEDWEATHER_QUANTITY)q, value);
+                }
+            }
+        }
+    }
+    float heldValue;
+    for (uint8_t q = 0; q < DERIVEDWEATHER_QUANTITY_COUNT; q++)
+    {
+        if ((availableQuantities & (1 << q)) && reportPolicies[q].Poll(heldValue))
+        {
+            Report((DERIVEDWEATHER_QUANTITY)q, heldValue);
+        }
+    }
+}
+
+bool DerivedWeather::Compute(const DERIVEDWEATHER_QUANTITY& Quantity, float& Value)
+{
+    float temperature = inputs[DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_TEMPERATURE];
+    float windKmh = inputs[DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_WINDSPEED] * 3.6f;
+    float humidity = inputs[DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_HUMIDITY];
+    bool hasWind = knownInputs & INPUT_BIT(DERIVEDWEATHER_INPUT_WINDSPEED);
+    bool hasHumidity = knownInputs & INPUT_BIT(DERIVEDWEATHER_INPUT_HUMIDITY);
+    switch (Quantity)
+    {
+    case DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_WINDCHILL:
+        Value = WindChill(temperature, windKmh);
+        return true;
+    case DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_DEWPOINT:
+        Value = DewPoint(temperature, humidity);
+        return !isnan(Value);
+    case DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_HEATINDEX:
+        Value = HeatIndex(temperature, humidity);
+        return true;
+    case DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE:
+        //Wind chill in the cold, heat index in the heat, else the temperature
+        if (hasWind && temperature <= DERIVEDWEATHER_WINDCHILL_MAX_TEMPERATURE)
+        {
+            Value = WindChill(temperature, windKmh);
+        }
+        else if (hasHumidity && temperature >= DERIVEDWEATHER_HEATINDEX_MIN_TEMPERATURE)
+        {
+            Value = HeatIndex(temperature, humidity);
+        }
+        else
+        {
+            Value = temperature;
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+void DerivedWeather::Report(const DERIVEDWEATHER_QUANTITY& Quantity, const float& Value)
+{
+    if (__CB_DERIVED_CHANGED != NULL)
+    {
+        __CB_DERIVED_CHANGED(Quantity, Value);
+    }
+}
+
+float DerivedWeather::WindChill(const float& Temperature, const float& WindKmh)
+{
+    //Wind chill index of Environment Canada / NWS (2001), wind at 10m in km/h
+    if (Temperature > DERIVEDWEATHER_WINDCHILL_MAX_TEMPERATURE || WindKmh <= DERIVEDWEATHER_WINDCHILL_MIN_WIND_KMH)
+    {
+        return Temperature;
+    }
+    float windFactor = powf(WindKmh, 0.16f);
+    return 13.12f + 0.6215f * Temperature - 11.37f * windFactor + 0.3965f * Temperature * windFactor;
+}
+
+float DerivedWeather::DewPoint(const float& Temperature, const float& RelativeHumidity)
+{
+    //Magnus formula with the Sonntag (1990) constants, within 0.35 degrees for -45..60 degrees
+    if (RelativeHumidity <= 0 || RelativeHumidity > 100)
+    {
+        return NAN;
+    }
+    const float a = 17.62f;
+    const float b = 243.12f;
+    float gamma = logf(RelativeHumidity / 100.0f) + (a * Temperature) / (b + Temperature);
+    return (b * gamma) / (a - gamma);
+}
+
+float DerivedWeather::HeatIndex(const float& Temperature, const float& RelativeHumidity)
+{
+    //NWS: the simple formula, the Rothfusz regression with its adjustments from 80 F, in Fahrenheit
+    float t = Temperature * 1.8f + 32.0f;
+    float rh = RelativeHumidity;
+    float hi = 0.5f * (t + 61.0f + (t - 68.0f) * 1.2f + rh * 0.094f);
+    if ((hi + t) / 2.0f >= 80.0f)
+    {
+        hi = -42.379f + 2.04901523f * t + 10.14333127f * rh - 0.22475541f * t * rh - 0.00683783f * t * t - 0.05481717f * rh * rh
+            + 0.00122874f * t * t * rh + 0.00085282f * t * rh * rh - 0.00000199f * t * t * rh * rh;
+        if (rh < 13.0f && t >= 80.0f && t <= 112.0f)
+        {
+            hi -= ((13.0f - rh) / 4.0f) * sqrtf((17.0f - fabsf(t - 95.0f)) / 17.0f);
+        }
+        else if (rh > 85.0f && t >= 80.0f && t <= 87.0f)
+        {
+            hi += ((rh - 85.0f) / 10.0f) * ((87.0f - t) / 5.0f);
+        }
+    }
+    return (hi - 32.0f) / 1.8f;
+}
+
+bool DerivedWeather::IsAvailable(const DERIVEDWEATHER_QUANTITY& Quantity)
+{
+    return Quantity < DERIVEDWEATHER_QUANTITY_COUNT && (availableQuantities & (1 << Quantity));
+}
+
+float DerivedWeather::GetValue(const DERIVEDWEATHER_QUANTITY& Quantity)
+{
+    return IsAvailable(Quantity) ? values[Quantity] : NAN;
+}
+
+uint32_t DerivedWeather::GetComputeCount(const DERIVEDWEATHER_QUANTITY& Quantity)
+{
+    return Quantity < DERIVEDWEATHER_QUANTITY_COUNT ? computeCount[Quantity] : 0;
+}
+
+String DerivedWeather::GetValues()
+{
+    String text;
+    for (uint8_t q = 0; q < DERIVEDWEATHER_QUANTITY_COUNT; q++)
+    {
+        if (IsAvailable((DERIVEDWEATHER_QUANTITY)q))
+        {
+            text += String("\r\n") + quantityNames[q] + ": " + String(values[q]) + " (" + String(computeCount[q]) + " computed)";
+        }
+    }
+    return text;
+}
@@ -0,0 +1,92 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// DerivedWeather.h
+
+#ifndef _DERIVEDWEATHER_h
+#define _DERIVEDWEATHER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "ReportPolicy.h"
+
+#define DERIVEDWEATHER_INPUT_COUNT 3
+#define DERIVEDWEATHER_QUANTITY_COUNT 4
+#define DERIVEDWEATHER_WINDCHILL_MAX_TEMPERATURE 10.0f //Wind chill is defined at or below 10 degrees
+#define DERIVEDWEATHER_WINDCHILL_MIN_WIND_KMH 4.8f //and above 4.8 km/h
+#define DERIVEDWEATHER_HEATINDEX_MIN_TEMPERATURE 26.7f //Heat index is defined from 80 F
+#define DERIVEDWEATHER_REPORT_POLICY 0.1f, 0, 0.05f, 0, 1800000 //Station report policy, see ReportPolicy::Configure
+
+namespace DERIVEDWEATHER_INPUTENUM
+{
+	enum DERIVEDWEATHER_INPUT :uint8_t
+	{
+		DERIVEDWEATHER_INPUT_TEMPERATURE = 0, //Degrees Celsius
+		DERIVEDWEATHER_INPUT_WINDSPEED = 1, //Mean wind speed, m/s
+		DERIVEDWEATHER_INPUT_HUMIDITY = 2, //Relative humidity, percent
+	};
+}
+typedef DERIVEDWEATHER_INPUTENUM::DERIVEDWEATHER_INPUT DERIVEDWEATHER_INPUT;
+
+namespace DERIVEDWEATHER_QUANTITYENUM
+{
+	enum DERIVEDWEATHER_QUANTITY :uint8_t
+	{
+		DERIVEDWEATHER_QUANTITY_WINDCHILL = 0, //Temperature, wind speed
+		DERIVEDWEATHER_QUANTITY_DEWPOINT = 1, //Temperature, humidity
+		DERIVEDWEATHER_QUANTITY_HEATINDEX = 2, //Temperature, humidity
+		DERIVEDWEATHER_QUANTITY_FEELSLIKE = 3, //Temperature, wind speed and humidity when known
+	};
+}
+typedef DERIVEDWEATHER_QUANTITYENUM::DERIVEDWEATHER_QUANTITY DERIVEDWEATHER_QUANTITY;
+
+//Values derived from the sensor readings. The inputs are fed from the sensor callbacks, Process() recomputes only
+//the quantities of which an input changed and passes changed values through their report policy to the callback.
+//A quantity is available once all of its required inputs were set, without a humidity source only wind chill and
+//feels-like are.
+class DerivedWeather
+{
+private:
+	float inputs[DERIVEDWEATHER_INPUT_COUNT];
+	uint8_t knownInputs = 0; //Bit per input
+	uint8_t dirtyQuantities = 0; //Bit per quantity
+	float values[DERIVEDWEATHER_QUANTITY_COUNT];
+	uint8_t availableQuantities = 0;
+	uint32_t computeCount[DERIVEDWEATHER_QUANTITY_COUNT];
+	ReportPolicy reportPolicies[DERIVEDWEATHER_QUANTITY_COUNT];
+	void(*__CB_DERIVED_CHANGED)(const DERIVEDWEATHER_QUANTITY& Quantity, const float& Value) = NULL;
+	void SetInput(const DERIVEDWEATHER_INPUT& Input, const float& Value);
+	bool Compute(const DERIVEDWEATHER_QUANTITY& Quantity, float& Value);
+	void Report(const DERIVEDWEATHER_QUANTITY& Quantity, const float& Value);
+public:
+	DerivedWeather();
+	void SetTemperature(const float& Temperature) { SetInput(DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_TEMPERATURE, Temperature); }
+	void SetWindSpeed(const float& MeanWindMS) { SetInput(DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_WINDSPEED, MeanWindMS); }
+	void SetHumidity(const float& RelativeHumidity) { SetInput(DERIVEDWEATHER_INPUT::DERIVEDWEATHER_INPUT_HUMIDITY, RelativeHumidity); }
+	void Process();
+	void SetOnDerivedValueChangeEvent(void(*callback)(const DERIVEDWEATHER_QUANTITY& Quantity, const float& Value)) { __CB_DERIVED_CHANGED = callback; }
+	bool IsAvailable(const DERIVEDWEATHER_QUANTITY& Quantity);
+	float GetValue(const DERIVEDWEATHER_QUANTITY& Quantity); //NAN when not available
+	uint32_t GetComputeCount(const DERIVEDWEATHER_QUANTITY& Quantity);
+	ReportPolicy& GetReportPolicy(const DERIVEDWEATHER_QUANTITY& Quantity) { return reportPolicies[Quantity < DERIVEDWEATHER_QUANTITY_COUNT ? Quantity : 0]; }
+	String GetValues();
+
+	static float WindChill(const float& Temperature, const float& WindKmh);
+	static float DewPoint(const float& Temperature, const float& RelativeHumidity);
+	static float HeatIndex(const float& Temperature, const float& RelativeHumidity);
+};
+
+#endif
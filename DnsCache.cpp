@@ -0,0 +1,140 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "DnsCache.h"
+#include <WiFi.h>
+
+DnsCache::DnsCache()
+{
+    Clear();
+}
+
+void DnsCache::Clear()
+{
+    for (uint8_t i = 0; i < DNSCACHE_SIZE; i++)
+    {
+        entries[i].host[0] = 0;
+        entries[i].isValid = false;
+        entries[i].isExpired = false;
+    }
+}
+
+DnsCacheEntry* DnsCache::Find(const char* HostName)
+{
+    for (uint8_t i = 0; i < DNSCACHE_SIZE; i++)
+    {
+        if (entries[i].isValid && strcmp(entries[i].host, HostName) == 0)
+        {
+            return &entries[i];
+        }
+    }
+    return NULL;
+}
+
+DnsCacheEntry* DnsCache::Allocate(const char* HostName)
+{
+    if (strlen(HostName) > DNSCACHE_HOST_LEN)
+    {
+        return NULL;
+    }
+    //An unused entry, else the least recently used one
+    DnsCacheEntry* entry = &entries[0];
+    for (uint8_t i = 0; i < DNSCACHE_SIZE; i++)
+    {
+        if (!entries[i].isValid)
+        {
+            entry = &entries[i];
+            break;
+        }
+        if (millis() - entries[i].lastUsedMillis > millis() - entry->lastUsedMillis)
+        {
+            entry = &entries[i];
+        }
+    }
+    strcpy(entry->host, HostName);
+    entry->isValid = false;
+    return entry;
+}
+
+bool DnsCache::IsFresh(const DnsCacheEntry& Entry)
+{
+    return !Entry.isExpired && millis() - Entry.resolvedMillis < ttlMs;
+}
+
+bool DnsCache::Resolve(const char* HostName, IPAddress& Address)
+{
+    if (Address.fromString(HostName))
+    {
+        return true;
+    }
+
+    DnsCacheEntry* entry = Find(HostName);
+    if (entry != NULL && IsFresh(*entry))
+    {
+        hitCount++;
+        entry->lastUsedMillis = millis();
+        Address = entry->address;
+        return true;
+    }
+
+    missCount++;
+    unsigned long lookupStart = millis();
+    IPAddress resolved;
+    bool isResolved = WiFi.hostByName(HostName, resolved) == 1;
+    lastLookupMillis = millis() - lookupStart;
+    totalLookupMillis += lastLookupMillis;
+    maxLookupMillis = lastLookupMillis > maxLookupMillis ? lastLookupMillis : maxLookupMillis;
+
+    if (isResolved)
+    {
+        if (entry == NULL)
+        {
+            entry = Allocate(HostName);
+        }
+        if (entry != NULL)
+        {
+            entry->address = resolved;
+            entry->resolvedMillis = millis();
+            entry->lastUsedMillis = entry->resolvedMillis;
+            entry->isValid = true;
+            entry->isExpired = false;
+        }
+        Address = resolved;
+        return true;
+    }
+
+    //Stale-if-error, the last answer is better than none
+    if (entry != NULL && millis() - entry->resolvedMillis < ttlMs + staleIfErrorMs)
+    {
+        staleCount++;
+        entry->lastUsedMillis = millis();
+        Address = entry->address;
+        return true;
+    }
+    failureCount++;
+    return false;
+}
+
+void DnsCache::Expire(const char* HostName)
+{
+    DnsCacheEntry* entry = Find(HostName);
+    if (entry != NULL)
+    {
+        entry->isExpired = true;
+    }
+}
+
+String DnsCache::ToString()
+{
+    return "Hit:" + String(hitCount) + " Miss:" + String(missCount) + " Stale:" + String(staleCount) + " Fail:" + String(failureCount) +
+        " Lookup:" + String(lastLookupMillis) + "ms Avg:" + String(GetAverageLookupMillis()) + "ms Max:" + String(maxLookupMillis) + "ms";
+}
@@ -0,0 +1,74 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// DnsCache.h
+
+#ifndef _DNSCACHE_h
+#define _DNSCACHE_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define DNSCACHE_SIZE 4 //Buienradar and the SysAP, with room to spare
+#define DNSCACHE_HOST_LEN 40 //Longer names are resolved every time
+#define DNSCACHE_TTL_MS 300000 //Cap on the record TTL, which WiFi.hostByName does not return. lwIP keeps the record for its own TTL.
+#define DNSCACHE_STALE_IF_ERROR_MS (24 * 3600000UL) //An expired entry is still used this long when the resolver fails
+
+struct DnsCacheEntry
+{
+	char host[DNSCACHE_HOST_LEN + 1];
+	IPAddress address;
+	unsigned long resolvedMillis;
+	unsigned long lastUsedMillis;
+	bool isValid;
+	bool isExpired; //Expired early, a connection to the address failed
+};
+
+//Resolves host names through WiFi.hostByName and keeps the answers for at most DNSCACHE_TTL_MS. Once expired the lookup
+//is answered by the lwIP table while the record TTL lasts, so a changed record is seen within the cap. When the resolver
+//fails an expired answer is served (stale-if-error). Literal IPv4 addresses are never looked up.
+class DnsCache
+{
+private:
+	DnsCacheEntry entries[DNSCACHE_SIZE];
+	unsigned long ttlMs = DNSCACHE_TTL_MS;
+	unsigned long staleIfErrorMs = DNSCACHE_STALE_IF_ERROR_MS;
+	uint32_t hitCount = 0;
+	uint32_t missCount = 0;
+	uint32_t staleCount = 0;
+	uint32_t failureCount = 0;
+	unsigned long lastLookupMillis = 0;
+	unsigned long maxLookupMillis = 0;
+	unsigned long totalLookupMillis = 0;
+	DnsCacheEntry* Find(const char* HostName);
+	DnsCacheEntry* Allocate(const char* HostName);
+	bool IsFresh(const DnsCacheEntry& Entry);
+public:
+	DnsCache();
+	void Configure(const unsigned long& TtlMs, const unsigned long& StaleIfErrorMs) { ttlMs = TtlMs; staleIfErrorMs = StaleIfErrorMs; }
+	bool Resolve(const char* HostName, IPAddress& Address);
+	void Expire(const char* HostName); //The address did not answer, look it up again on the next Resolve()
+	void Clear();
+	uint32_t GetHitCount() { return hitCount; }
+	uint32_t GetMissCount() { return missCount; } //Lookups, successful or not
+	uint32_t GetStaleCount() { return staleCount; }
+	uint32_t GetFailureCount() { return failureCount; } //Lookups that failed without a stale entry to serve
+	unsigned long GetLastLookupMillis() { return lastLookupMillis; }
+	unsigned long GetMaxLookupMillis() { return maxLookupMillis; }
+	unsigned long GetAverageLookupMillis() { return missCount == 0 ? 0 : totalLookupMillis / missCount; }
+	String ToString();
+};
+
+#endif
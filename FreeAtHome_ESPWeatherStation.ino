@@ -48,17 +48,24 @@ FahESPWeatherStation* espWeer = NULL;
 #include "WindSpeed.h"
 #include "TemperatureSensor.h"
 #include "BrightnessSensor.h"
+#include "DerivedWeather.h"
+#include "DnsCache.h"
 
 #define PIN_WINDSPEED_INTERRUPT 34 //Interrupt (Wind Speed)
 #define PIN_ONEWIREBUS_TEMPERATURE 27 //Temperature Outside
 #define PIN_LIGHT_SENSOR A0 //Light Intensity
+#define MENU_DERIVED_REFRESH_INTERVAL 10000 //Derived values rebuild the status menu at most at the page refresh rate
 Buienradar* oBuienradar;
 WindSpeed* oWindspeed;
 TemperatureSensor* oTemperature;
 BrightnessSensor* oBrightness;
+DerivedWeather* oDerived;
+DnsCache dnsCache; //The SysAP, Buienradar connects by name for TLS
 
 String deviceID;
 String menuHtml;
+unsigned long menuBuildMillis = 0;
+bool isMenuDerivedPending = false;
 
 unsigned long previousMillis = 0;
 unsigned long interval = 30000;
@@ -73,7 +80,7 @@ uint8_t handler = 0;
 //unsigned long lastUpdateTimer = 0;
 constexpr size_t CUSTOM_FIELD_LEN = 40;
 constexpr size_t LONLAT_FIELD_LEN = 10;
-constexpr std::array<ParamEntry, 6> PARAMS = { {
+constexpr std::array<ParamEntry, 9> PARAMS = { {
     {
       "Ap",
       "SysAp",
@@ -109,17 +116,40 @@ constexpr std::array<ParamEntry, 6> PARAMS = { {
       "Name",
       CUSTOM_FIELD_LEN,
       ""
+    },
+    {
+      "lx",
+      "Lux calibration (raw:lux,raw:lux,...)",
+      LUXCALIBRATION_FIELD_LEN,
+      ""
+    },
+    {
+      "tr",
+      "Temperature resolution (9..12 bit)",
+      TEMPERATURE_PROFILE_FIELD_LEN,
+      ""
+    },
+    {
+      "tp",
+      "Temperature probe channels (ROM,ROM,...)",
+      TEMPERATURE_PROBEMAP_FIELD_LEN,
+      ""
     }
 } };
 
 String GetWeerStatus()
 {
-    String WeerInfo = String(F("Temp: {0}<br>Light: {1}<br>WindMS: {2}<br>WindBau: {3}<br>Rain: {4}"));
+    String WeerInfo = String(F("Temp: {0}<br>Light: {1}<br>WindMS: {2}<br>WindBau: {3}<br>Rain: {4}<br>FeelsLike: {5}<br>RainIn: {6}"));
     WeerInfo.replace("{0}", String(oTemperature->GetTemperature()));
     WeerInfo.replace("{1}", String(oBrightness->GetBrightness()));
     WeerInfo.replace("{2}", String(oWindspeed->GetWindGusts()));
     WeerInfo.replace("{3}", String(oWindspeed->GetSpeedBeaufort()));
     WeerInfo.replace("{4}", String(oBuienradar->GetExpectedAmountOfRain()));
+    //Not available yet: the outside temperature, like SendLegacyRest
+    float feelsLike = oDerived->GetValue(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE);
+    feelsLike = isnan(feelsLike) ? oTemperature->GetTemperature() : feelsLike;
+    WeerInfo.replace("{5}", String(feelsLike));
+    WeerInfo.replace("{6}", String(oBuienradar->GetForecast().GetMinutesToRain()));
     return WeerInfo;
 }
 
@@ -151,6 +181,9 @@ void SetCustomMenu(String StatusText)
     DEBUG_PL(StatusText);
 
     wm.setCustomMenuHTML(menuHtml.c_str());
+    //The status includes the current derived values
+    menuBuildMillis = millis();
+    isMenuDerivedPending = false;
 }
 
 void RegenCallback(const bool& isRainOrExpected, const float& amount)
@@ -195,6 +228,7 @@ void WindBeaufortCallback(const uint8_t& amount)
 
 void TemperatureCallback(const float& amount)
 {
+    oDerived->SetTemperature(amount);
     if (espWeer != NULL)
     {
         espWeer->SetTemperatureLevel(amount);
@@ -203,6 +237,21 @@ void TemperatureCallback(const float& amount)
     }
 }
 
+void WindMeanCallback(const float& amount)
+{
+    oDerived->SetWindSpeed(amount);
+}
+
+void DerivedCallback(const DERIVEDWEATHER_QUANTITY& quantity, const float& amount)
+{
+    //Free@Home has no datapoints for derived values, they are on the status menu, /rest and /fah.
+    //The menu is rebuilt from the loop, not on every change.
+    if (espWeer != NULL && quantity == DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE)
+    {
+        isMenuDerivedPending = true;
+    }
+}
+
 void SendWindDebug()
 {
     if (oWindspeed == NULL)
@@ -217,19 +266,25 @@ void SendWindDebug()
 
 void SendLegacyRest()
 {
-    if (oWindspeed == NULL || oTemperature == NULL || oBrightness == NULL)
+    if (oWindspeed == NULL || oTemperature == NULL || oBrightness == NULL || oDerived == NULL)
     {
         wm.server->send(503, String(F("text/plain")), String(F("Not Ready")));
     }
     else
     {
-        char temp[200];
+        char temp[260];
         float wsms = oWindspeed->GetWindGusts();
+        float mwsms = oWindspeed->GetWindMean();
+        float iwsms = oWindspeed->GetInstantWindMS();
         unsigned int awsms = oWindspeed->GetSpeedBeaufort();
         unsigned long long uptime = esp_timer_get_time() / 1000 / 1000;
         unsigned long SunLightLevel = oBrightness->GetBrightness();
         float temperatureCoutside = oTemperature->GetTemperature();
-        snprintf(temp, 200, String("{\"weather\":{\"windmax\":\"%2.1f\",\"windavg\":\"%u\",\"sun\":\"%u\",\"temperature\":\"%4.1f\",\"uptm\":\"%llu\"}}").c_str(), wsms, awsms, SunLightLevel, temperatureCoutside, uptime);
+        float windChill = oDerived->GetValue(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_WINDCHILL);
+        float feelsLike = oDerived->GetValue(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE);
+        windChill = isnan(windChill) ? temperatureCoutside : windChill;
+        feelsLike = isnan(feelsLike) ? temperatureCoutside : feelsLike;
+        snprintf(temp, 260, String("{\"weather\":{\"windmax\":\"%2.1f\",\"windmean\":\"%2.1f\",\"windnow\":\"%2.1f\",\"windavg\":\"%u\",\"sun\":\"%u\",\"temperature\":\"%4.1f\",\"windchill\":\"%4.1f\",\"feelslike\":\"%4.1f\",\"uptm\":\"%llu\"}}").c_str(), wsms, mwsms, iwsms, awsms, SunLightLevel, temperatureCoutside, windChill, feelsLike, uptime);
         wm.server->send(200, String("application/json"), temp);
     }
 }
@@ -257,12 +312,50 @@ void handleDevice()
         Text += String(F("\r\nMSC: ")) + String(espWeer->GetMScounter());
     }
 
+    if (oBrightness != NULL)
+    {
+        Text += String(F("\r\nLightRaw: ")) + String(oBrightness->GetRawBrightness());
+        Text += String(F("\r\nLuxCal: ")) + oBrightness->GetLuxCalibration();
+        Text += String(F("\r\nReportLux: ")) + oBrightness->GetReportPolicy().ToString();
+    }
+
+    if (oWindspeed != NULL && oTemperature != NULL)
+    {
+        Text += String(F("\r\nReportGust: ")) + oWindspeed->GetGustReportPolicy().ToString();
+        Text += String(F("\r\nReportBeaufort: ")) + oWindspeed->GetBeaufortReportPolicy().ToString();
+        Text += String(F("\r\nReportTemp: ")) + oTemperature->GetReportPolicy().ToString();
+        Text += String(F("\r\nOneWire: ")) + (oTemperature->GetBusType() == TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT ? String(F("RMT")) : String(F("bitbang")));
+        Text += String(F("\r\nTempProfile: ")) + oTemperature->GetProfileString();
+        for (uint8_t profile = 0; profile < TEMPERATURE_PROFILE_COUNT; profile++)
+        {
+            unsigned long conversionMillis = oTemperature->GetMeasuredConversionMillis((TEMPERATURE_PROFILE)profile);
+            if (conversionMillis > 0)
+            {
+                Text += String(F("\r\nConversion")) + String(TemperatureSensor::GetProfileSettings((TEMPERATURE_PROFILE)profile).resolution) + String(F("bit: ")) + String(conversionMillis) + String(F("ms"));
+            }
+        }
+        for (uint8_t probe = 0; probe < oTemperature->GetProbeCount(); probe++)
+        {
+            Text += String(F("\r\nProbe")) + String(probe) + ": " + oTemperature->GetProbeAddress(probe) + " " + String(oTemperature->GetProbeTemperature(probe)) + (oTemperature->IsProbePresent(probe) ? "" : String(F(" missing")));
+        }
+    }
+
+    if (oDerived != NULL)
+    {
+        Text += oDerived->GetValues();
+    }
+
     if (oBuienradar != NULL)
     {
         Text += String(F("\r\nBS: ")) + String(oBuienradar->GetLastRequestSucceeded());
         Text += String(F("\r\nWT: ")) + String(oBuienradar->GetWaitTime());
         Text += String(F("\r\nRS: ")) + String(oBuienradar->GetRefreshSecondsRemaining());
-        Text += String(F("\r\nLBD: ")) + oBuienradar->LastBodyData;
+        Text += String(F("\r\nCB: ")) + oBuienradar->GetRetryPolicy().ToString();
+        Text += String(F("\r\nReportRain: ")) + oBuienradar->GetReportPolicy().ToString();
+        Text += String(F("\r\nLBD: ")) + oBuienradar->GetLastBodyData();
+        Text += String(F("\r\nRainForecast: ")) + oBuienradar->GetForecast().ToString();
+        Text += String(F("\r\nTLS: ")) + oBuienradar->GetConnectionStats();
+        Text += String(F("\r\nDNS: ")) + dnsCache.ToString();
     }
 
     wm.server->send(200, String(F("text/plain")), Text.c_str());
@@ -305,15 +398,54 @@ void setup()
         wm.setMenu(_menuIdsUpdate);
     }
 
-    oWindspeed = new WindSpeed(PIN_WINDSPEED_INTERRUPT);
+    //Fed by the sensor callbacks, created first
+    oDerived = new DerivedWeather();
+    oDerived->SetOnDerivedValueChangeEvent(DerivedCallback);
+    for (uint8_t quantity = 0; quantity < DERIVEDWEATHER_QUANTITY_COUNT; quantity++)
+    {
+        oDerived->GetReportPolicy((DERIVEDWEATHER_QUANTITY)quantity).Configure(DERIVEDWEATHER_REPORT_POLICY);
+    }
+
+    //The reed switch bounces, only the interrupt counter debounces it. PCNT is for a bounce free anemometer.
+    oWindspeed = new WindSpeed(PIN_WINDSPEED_INTERRUPT, WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR);
+    if (!oWindspeed->SetDebounceMicros(WINDPULSECOUNTER_DEBOUNCE_US))
+    {
+        DEBUG_PL(F("Wind pulse debounce not set"));
+    }
     oWindspeed->SetOnWindBeaufortChangeEvent(WindBeaufortCallback);
     oWindspeed->SetOnWindGustsChangeEvent(WindMSCallback);
-
-    oBrightness = new BrightnessSensor(PIN_LIGHT_SENSOR);
+    oWindspeed->SetOnWindMeanChangeEvent(WindMeanCallback);
+    oWindspeed->SetAdaptiveCadence(true); //Report every 10s when gusty, every 60s when calm
+    oWindspeed->GetGustReportPolicy().Configure(WINDSPEED_GUST_REPORT_POLICY);
+    oWindspeed->GetMeanReportPolicy().Configure(WINDSPEED_MEAN_REPORT_POLICY);
+    oWindspeed->GetBeaufortReportPolicy().Configure(WINDSPEED_BEAUFORT_REPORT_POLICY);
+
+    oBrightness = new BrightnessSensor(PIN_LIGHT_SENSOR, BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS);
+    oBrightness->SetFilter(BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_MEDIAN); //Ignore headlights and shadows
     oBrightness->SetOnLuxValueChangeEvent(LightCallback);
+    oBrightness->GetReportPolicy().Configure(BRIGHTNESS_REPORT_POLICY);
+    if (!oBrightness->SetLuxCalibration(wm_helper.GetSetting(6)))
+    {
+        DEBUG_PL(F("Invalid lux calibration, using default"));
+    }
 
-    oTemperature = new TemperatureSensor(PIN_ONEWIREBUS_TEMPERATURE);
+    oTemperature = new TemperatureSensor(PIN_ONEWIREBUS_TEMPERATURE, TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT);
     oTemperature->SetOnTemperatureChangeEvent(TemperatureCallback);
+    for (uint8_t probe = 0; probe < TEMPERATURE_MAX_PROBES; probe++)
+    {
+        oTemperature->GetReportPolicy(probe).Configure(TEMPERATURE_REPORT_POLICY);
+    }
+    //Empty keeps the 12 bit profile
+    int temperatureResolution = atoi(wm_helper.GetSetting(7));
+    if (temperatureResolution >= 9 && temperatureResolution <= 12)
+    {
+        oTemperature->SetProfile((TEMPERATURE_PROFILE)(temperatureResolution - 9));
+    }
+    //Probes keep their channel over restarts, also when a probe is added that the bus search finds first
+    if (!oTemperature->SetProbeMap(wm_helper.GetSetting(8)))
+    {
+        DEBUG_PL(F("Invalid temperature probe channels, using bus order"));
+    }
 
     String lon = wm_helper.GetSetting(3);
     String lat = wm_helper.GetSetting(4);
@@ -326,6 +458,8 @@ void setup()
 
     oBuienradar = new Buienradar(lon, lat);
     oBuienradar->SetOnRainReportEvent(RegenCallback);
+    oBuienradar->GetReportPolicy().Configure(BUIENRADAR_REPORT_POLICY);
+    oBuienradar->GetRetryPolicy().Seed(esp_random());
 
     wm.server->on("/wind", SendWindDebug);
     wm.server->on("/rest", SendLegacyRest);
@@ -338,7 +472,8 @@ void FahCallBack(FAHESPAPI_EVENT Event, uint64_t FAHID, const char* ptrChannel,
         DEBUG_P(F("PARM_DISPLAYNAME "));
         const char* val = ((char*)ptrValue);
         DEBUG_PL(val);
-        wm_helper.setSetting(5, val, strlen(val));
+        //The field length, the helper saves each field at its length and the fields after it would shift
+        wm_helper.setSetting(5, val, CUSTOM_FIELD_LEN);
     }
 }
 
@@ -372,8 +507,17 @@ void loop()
             if ((strlen(wm_helper.GetSetting(0)) > 0) && (strlen(wm_helper.GetSetting(1)) > 0) && (strlen(wm_helper.GetSetting(2)) > 0))
             {
                 //Serial.println(F("Connecting WebSocket"));
-                if (!freeAtHomeESPapi.ConnectToSysAP(wm_helper.GetSetting(0), wm_helper.GetSetting(1), wm_helper.GetSetting(2), false))
+                //A SysAP configured by name is resolved through the cache, if that fails the API tries the name itself
+                String sysAp = wm_helper.GetSetting(0);
+                IPAddress sysApAddress;
+                if (dnsCache.Resolve(sysAp.c_str(), sysApAddress))
                 {
+                    sysAp = sysApAddress.toString();
+                }
+                if (!freeAtHomeESPapi.ConnectToSysAP(sysAp.c_str(), wm_helper.GetSetting(1), wm_helper.GetSetting(2), false))
+                {
+                    //The SysAP may have moved, look it up again on the next attempt
+                    dnsCache.Expire(wm_helper.GetSetting(0));
                     SetCustomMenu(String(F("SysAp connect error")));
                     //Prevent to many retries
                     registrationDelay = 10000;
@@ -426,6 +570,8 @@ void loop()
             }
             else
             {
+                //Every pass, Process below only runs once per handler cycle
+                oTemperature->PollConversion();
                 switch (handler)
                 {
                 case 0:
@@ -436,10 +582,22 @@ void loop()
                     break;
                 case 60:
                     oTemperature->Process();
+                    if (oTemperature->IsProbeMapChanged())
+                    {
+                        String probeMap = oTemperature->GetProbeMap();
+                        wm_helper.setSetting(8, probeMap.c_str(), TEMPERATURE_PROBEMAP_FIELD_LEN);
+                    }
                     break;
                 case 90:
                     oBrightness->Process();
                     break;
+                case 120:
+                    oDerived->Process();
+                    if (isMenuDerivedPending && millis() - menuBuildMillis >= MENU_DERIVED_REFRESH_INTERVAL)
+                    {
+                        SetCustomMenu(String(F("Feels Like Update")));
+                    }
+                    break;
                 default:
                     oBuienradar->Process();
                     delay(1);
@@ -0,0 +1,138 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "LuxCalibration.h"
+#include "ConversionTables.h"
+
+static bool ParseNumber(const char*& Text, uint16_t& Value)
+{
+    while (*Text == ' ')
+    {
+        Text++;
+    }
+    if (*Text < '0' || *Text > '9')
+    {
+        return false;
+    }
+    uint32_t number = 0;
+    while (*Text >= '0' && *Text <= '9')
+    {
+        number = number * 10 + (uint32_t)(*Text - '0');
+        if (number > 0xFFFF)
+        {
+            return false;
+        }
+        Text++;
+    }
+    while (*Text == ' ')
+    {
+        Text++;
+    }
+    Value = (uint16_t)number;
+    return true;
+}
+
+bool LuxCalibration::Parse(const char* Text)
+{
+    if (Text == NULL || *Text == 0)
+    {
+        pointCount = 0;
+        return true;
+    }
+    uint16_t raw[LUXCALIBRATION_MAX_POINTS];
+    uint16_t lux[LUXCALIBRATION_MAX_POINTS];
+    uint8_t count = 0;
+    while (*Text != 0)
+    {
+        if (count >= LUXCALIBRATION_MAX_POINTS || !ParseNumber(Text, raw[count]) || *Text++ != ':' || !ParseNumber(Text, lux[count]))
+        {
+            return false;
+        }
+        //Raw values must be strictly ascending
+        if (count > 0 && raw[count] <= raw[count - 1])
+        {
+            return false;
+        }
+        count++;
+        if (*Text == ',')
+        {
+            Text++;
+        }
+        else if (*Text != 0)
+        {
+            return false;
+        }
+    }
+    if (count < 2)
+    {
+        return false;
+    }
+    for (uint8_t i = 0; i < count; i++)
+    {
+        pointRaw[i] = raw[i];
+        pointLux[i] = lux[i];
+    }
+    pointCount = count;
+    return true;
+}
+
+uint16_t LuxCalibration::Convert(const uint16_t& Raw)
+{
+    if (pointCount < 2)
+    {
+        return ConversionTables::Lux(Raw);
+    }
+    if (Raw <= pointRaw[0])
+    {
+        return pointLux[0];
+    }
+    if (Raw >= pointRaw[pointCount - 1])
+    {
+        return pointLux[pointCount - 1];
+    }
+    //Last point with pointRaw <= Raw, the segment runs from there to the next point
+    uint8_t low = 0;
+    uint8_t high = pointCount - 1;
+    while (high - low > 1)
+    {
+        uint8_t mid = (low + high) / 2;
+        if (pointRaw[mid] <= Raw)
+        {
+            low = mid;
+        }
+        else
+        {
+            high = mid;
+        }
+    }
+    int32_t luxDelta = (int32_t)pointLux[high] - (int32_t)pointLux[low];
+    int32_t rawSpan = (int32_t)pointRaw[high] - (int32_t)pointRaw[low];
+    return (uint16_t)((int32_t)pointLux[low] + (luxDelta * (int32_t)(Raw - pointRaw[low])) / rawSpan);
+}
+
+String LuxCalibration::ToString()
+{
+    if (pointCount < 2)
+    {
+        return String(F("raw+(raw/15)^2"));
+    }
+    String Text = "";
+    for (uint8_t i = 0; i < pointCount; i++)
+    {
+        if (i > 0)
+        {
+            Text += ",";
+        }
+        Text += String(pointRaw[i]) + ":" + String(pointLux[i]);
+    }
+    return Text;
+}
@@ -0,0 +1,42 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// LuxCalibration.h
+
+#ifndef _LUXCALIBRATION_h
+#define _LUXCALIBRATION_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define LUXCALIBRATION_MAX_POINTS 12
+#define LUXCALIBRATION_FIELD_LEN (LUXCALIBRATION_MAX_POINTS * 11) //Config text, "raw:lux,raw:lux,...", each point at most "4095:65535,"
+
+//Raw light sensor value to lux. Without a table the original estimate raw + (raw / 15)^2 is used,
+//with a table the lux is interpolated linearly between the points and held at the first and last point.
+class LuxCalibration
+{
+private:
+	uint16_t pointRaw[LUXCALIBRATION_MAX_POINTS] = { 0 };
+	uint16_t pointLux[LUXCALIBRATION_MAX_POINTS] = { 0 };
+	uint8_t pointCount = 0;
+public:
+	bool Parse(const char* Text); //Keeps the current table when the text is not valid, empty text removes the table
+	uint16_t Convert(const uint16_t& Raw);
+	uint8_t GetPointCount() { return pointCount; }
+	String ToString();
+};
+
+#endif
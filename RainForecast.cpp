@@ -0,0 +1,120 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "RainForecast.h"
+#include "ConversionTables.h"
+
+void RainForecast::Update(const RainTextParser& RainText)
+{
+    slotCount = RainText.GetSampleCount();
+    for (uint8_t i = 0; i < slotCount; i++)
+    {
+        slots[i] = RainText.GetSample(i);
+    }
+    updateMillis = millis();
+}
+
+uint16_t RainForecast::GetSlotOffset(const uint8_t& Index) const
+{
+    //The nowcast may pass midnight
+    return (slots[Index].minuteOfDay + 1440 - slots[0].minuteOfDay) % 1440;
+}
+
+uint16_t RainForecast::GetElapsedMinutes() const
+{
+    unsigned long elapsed = (millis() - updateMillis) / 60000;
+    return elapsed > 0xFFFF ? 0xFFFF : (uint16_t)elapsed;
+}
+
+uint16_t RainForecast::GetHorizonMinutes() const
+{
+    if (slotCount == 0)
+    {
+        return 0;
+    }
+    uint16_t end = GetSlotOffset(slotCount - 1) + RAINFORECAST_SLOT_MINUTES;
+    uint16_t elapsed = GetElapsedMinutes();
+    return end > elapsed ? end - elapsed : 0;
+}
+
+float RainForecast::GetRainRate(const uint16_t& Intensity)
+{
+    if (Intensity == 0)
+    {
+        return 0;
+    }
+    return ConversionTables::RainAmount((int)Intensity);
+}
+
+int16_t RainForecast::GetMinutesToRain() const
+{
+    uint16_t elapsed = GetElapsedMinutes();
+    for (uint8_t i = 0; i < slotCount; i++)
+    {
+        uint16_t offset = GetSlotOffset(i);
+        if (slots[i].intensity > 0 && offset + RAINFORECAST_SLOT_MINUTES > elapsed)
+        {
+            return offset > elapsed ? offset - elapsed : 0;
+        }
+    }
+    return RAINFORECAST_NONE;
+}
+
+int16_t RainForecast::GetMinutesToRainEnd() const
+{
+    uint16_t elapsed = GetElapsedMinutes();
+    bool isRaining = false;
+    for (uint8_t i = 0; i < slotCount; i++)
+    {
+        uint16_t offset = GetSlotOffset(i);
+        if (offset + RAINFORECAST_SLOT_MINUTES <= elapsed)
+        {
+            continue;
+        }
+        if (slots[i].intensity > 0)
+        {
+            isRaining = true;
+        }
+        else if (isRaining)
+        {
+            return offset > elapsed ? offset - elapsed : 0;
+        }
+    }
+    return RAINFORECAST_NONE;
+}
+
+float RainForecast::GetExpectedRainMm(const uint16_t& Minutes) const
+{
+    uint16_t from = GetElapsedMinutes();
+    uint32_t to = (uint32_t)from + Minutes;
+    float total = 0;
+    for (uint8_t i = 0; i < slotCount; i++)
+    {
+        uint32_t start = GetSlotOffset(i);
+        uint32_t end = start + RAINFORECAST_SLOT_MINUTES;
+        start = start < from ? from : start;
+        end = end > to ? to : end;
+        if (end > start && slots[i].intensity > 0)
+        {
+            total += GetRainRate(slots[i].intensity) * (float)(end - start) / 60.0f;
+        }
+    }
+    return total;
+}
+
+String RainForecast::ToString() const
+{
+    char text[112];
+    snprintf(text, sizeof(text), "slots %u, horizon %u min, rain in %d min, ends in %d min, next hour %.2f mm", slotCount, GetHorizonMinutes(),
+        GetMinutesToRain(), GetMinutesToRainEnd(), GetExpectedRainMm(60));
+    return String(text);
+}
@@ -0,0 +1,54 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// RainForecast.h
+
+#ifndef _RAINFORECAST_h
+#define _RAINFORECAST_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "RainTextParser.h"
+
+#define RAINFORECAST_SLOT_MINUTES 5 //Every raintext line is the forecast for 5 minutes
+#define RAINFORECAST_NONE -1 //No rain (or no end of the rain) within the forecast
+
+//The two hour Buienradar nowcast of the last successful poll. The first slot is taken to start when the
+//forecast was received, later slots are placed by their minute-of-day, so the station needs no clock.
+//All minutes are counted from now, the forecast ages while it is kept.
+class RainForecast
+{
+private:
+	RainTextSample slots[RAINTEXT_MAX_SAMPLES];
+	uint8_t slotCount = 0;
+	unsigned long updateMillis = 0;
+	uint16_t GetSlotOffset(const uint8_t& Index) const;
+	uint16_t GetElapsedMinutes() const;
+public:
+	RainForecast() {}
+	void Update(const RainTextParser& RainText);
+	void Clear() { slotCount = 0; }
+	uint8_t GetSlotCount() const { return slotCount; }
+	const RainTextSample& GetSlot(const uint8_t& Index) const { return slots[Index]; }
+	uint16_t GetHorizonMinutes() const; //Minutes until the end of the forecast
+	int16_t GetMinutesToRain() const; //0 when it rains now
+	int16_t GetMinutesToRainEnd() const; //First dry slot after the rain starts
+	float GetExpectedRainMm(const uint16_t& Minutes) const; //Total over the next Minutes, limited to the forecast
+	static float GetRainRate(const uint16_t& Intensity); //mm/h, 0 for intensity 0
+	String ToString() const;
+};
+
+#endif
@@ -0,0 +1,137 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "RainTextParser.h"
+
+void RainTextParser::Reset()
+{
+    sampleCount = 0;
+    state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INTENSITY;
+    intensity = 0;
+    hour = 0;
+    minute = 0;
+    digitCount = 0;
+    byteCount = 0;
+}
+
+void RainTextParser::Feed(const uint8_t* Data, const size_t& Length)
+{
+    for (size_t i = 0; i < Length; i++)
+    {
+        diagnostics[byteCount % RAINTEXT_DIAGNOSTIC_SIZE] = (char)Data[i];
+        byteCount++;
+        if (state != RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INVALID)
+        {
+            ParseByte((char)Data[i]);
+        }
+    }
+}
+
+void RainTextParser::ParseByte(const char& Value)
+{
+    bool isDigit = Value >= '0' && Value <= '9';
+    switch (state)
+    {
+        case RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INTENSITY:
+            if (isDigit && digitCount < 3)
+            {
+                intensity = intensity * 10 + (Value - '0');
+                digitCount++;
+                return;
+            }
+            else if (Value == '|' && digitCount > 0 && intensity <= RAINTEXT_MAX_INTENSITY)
+            {
+                digitCount = 0;
+                state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_HOUR;
+                return;
+            }
+            break;
+
+        case RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_HOUR:
+            if (isDigit && digitCount < 2)
+            {
+                hour = hour * 10 + (Value - '0');
+                digitCount++;
+                return;
+            }
+            else if (Value == ':' && digitCount > 0 && hour < 24)
+            {
+                digitCount = 0;
+                state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_MINUTE;
+                return;
+            }
+            break;
+
+        case RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_MINUTE:
+            if (isDigit && digitCount < 2)
+            {
+                minute = minute * 10 + (Value - '0');
+                digitCount++;
+                return;
+            }
+            else if (digitCount > 0 && minute < 60)
+            {
+                if (Value == '\r')
+                {
+                    state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_END_OF_LINE;
+                    return;
+                }
+                else if (Value == '\n')
+                {
+                    CompleteLine();
+                    return;
+                }
+            }
+            break;
+
+        case RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_END_OF_LINE:
+            if (Value == '\n')
+            {
+                CompleteLine();
+                return;
+            }
+            break;
+
+        default:
+            return;
+    }
+    //Anything else is not raintext, keep the samples parsed so far
+    state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INVALID;
+}
+
+void RainTextParser::CompleteLine()
+{
+    if (sampleCount < RAINTEXT_MAX_SAMPLES)
+    {
+        samples[sampleCount].intensity = intensity;
+        samples[sampleCount].minuteOfDay = hour * 60 + minute;
+        sampleCount++;
+    }
+    intensity = 0;
+    hour = 0;
+    minute = 0;
+    digitCount = 0;
+    state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INTENSITY;
+}
+
+String RainTextParser::GetDiagnostics() const
+{
+    uint32_t count = byteCount < RAINTEXT_DIAGNOSTIC_SIZE ? byteCount : RAINTEXT_DIAGNOSTIC_SIZE;
+    char text[RAINTEXT_DIAGNOSTIC_SIZE + 1];
+    for (uint32_t i = 0; i < count; i++)
+    {
+        char c = diagnostics[(byteCount - count + i) % RAINTEXT_DIAGNOSTIC_SIZE];
+        text[i] = (c < ' ' || c > '~') ? '~' : c;
+    }
+    text[count] = 0;
+    return String(text);
+}
@@ -0,0 +1,74 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// RainTextParser.h
+
+#ifndef _RAINTEXTPARSER_h
+#define _RAINTEXTPARSER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define RAINTEXT_MAX_SAMPLES 25 //Two hours of 5 minute forecasts, including the current one
+#define RAINTEXT_DIAGNOSTIC_SIZE 64 //Last bytes of the payload kept for the status page
+#define RAINTEXT_MAX_INTENSITY 255
+
+namespace RAINTEXTPARSER_STATEENUM
+{
+	enum RAINTEXTPARSER_STATE :uint8_t
+	{
+		RAINTEXTPARSER_STATE_INTENSITY = 0,
+		RAINTEXTPARSER_STATE_HOUR = 1,
+		RAINTEXTPARSER_STATE_MINUTE = 2,
+		RAINTEXTPARSER_STATE_END_OF_LINE = 3,
+		RAINTEXTPARSER_STATE_INVALID = 4,
+	};
+}
+typedef RAINTEXTPARSER_STATEENUM::RAINTEXTPARSER_STATE RAINTEXTPARSER_STATE;
+
+struct RainTextSample
+{
+	uint16_t intensity; //0..255, see ConversionTables::RainAmount
+	uint16_t minuteOfDay; //Local time of the forecast, 0..1439
+};
+
+//Parses the Buienradar raintext payload ("NNN|HH:MM" lines) while it is received, without heap allocations.
+//Only lines terminated by a newline are samples, parsing stops at the first malformed line.
+class RainTextParser
+{
+private:
+	RainTextSample samples[RAINTEXT_MAX_SAMPLES];
+	uint8_t sampleCount = 0;
+	RAINTEXTPARSER_STATE state = RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INTENSITY;
+	uint16_t intensity = 0;
+	uint16_t hour = 0;
+	uint16_t minute = 0;
+	uint8_t digitCount = 0;
+	uint32_t byteCount = 0;
+	char diagnostics[RAINTEXT_DIAGNOSTIC_SIZE];
+	void ParseByte(const char& Value);
+	void CompleteLine();
+public:
+	RainTextParser() {}
+	void Reset();
+	void Feed(const uint8_t* Data, const size_t& Length);
+	uint8_t GetSampleCount() const { return sampleCount; }
+	const RainTextSample& GetSample(const uint8_t& Index) const { return samples[Index]; }
+	uint32_t GetByteCount() const { return byteCount; }
+	bool IsValid() const { return state != RAINTEXTPARSER_STATE::RAINTEXTPARSER_STATE_INVALID; }
+	String GetDiagnostics() const; //Last received bytes, oldest first, control characters shown as '~'
+};
+
+#endif
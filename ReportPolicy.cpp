@@ -0,0 +1,109 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "ReportPolicy.h"
+
+ReportPolicy::ReportPolicy(const float& AbsoluteDeadband, const float& RelativeDeadband, const float& Hysteresis, const unsigned long& MinIntervalMs, const unsigned long& MaxIntervalMs)
+{
+    Configure(AbsoluteDeadband, RelativeDeadband, Hysteresis, MinIntervalMs, MaxIntervalMs);
+}
+
+void ReportPolicy::Configure(const float& AbsoluteDeadband, const float& RelativeDeadband, const float& Hysteresis, const unsigned long& MinIntervalMs, const unsigned long& MaxIntervalMs)
+{
+    absoluteDeadband = AbsoluteDeadband < 0 ? 0 : AbsoluteDeadband;
+    relativeDeadband = RelativeDeadband < 0 ? 0 : RelativeDeadband;
+    hysteresis = Hysteresis < 0 ? 0 : Hysteresis;
+    minIntervalMs = MinIntervalMs;
+    maxIntervalMs = MaxIntervalMs;
+}
+
+bool ReportPolicy::ExceedsDeadband(const float& Value)
+{
+    if (!hasReported)
+    {
+        return true;
+    }
+    float change = Value - lastReported;
+    if (change == 0)
+    {
+        return false;
+    }
+    float magnitude = change < 0 ? -change : change;
+    float reference = lastReported < 0 ? -lastReported : lastReported;
+    float deadband = reference * relativeDeadband;
+    if (deadband < absoluteDeadband)
+    {
+        deadband = absoluteDeadband;
+    }
+    int8_t direction = change < 0 ? -1 : 1;
+    if (lastDirection != 0 && direction != lastDirection)
+    {
+        deadband += hysteresis;
+    }
+    //Without a deadband every change is reported
+    return deadband == 0 || magnitude > deadband;
+}
+
+void ReportPolicy::MarkReported(const float& Value)
+{
+    if (hasReported && Value != lastReported)
+    {
+        lastDirection = Value < lastReported ? -1 : 1;
+    }
+    lastReported = Value;
+    hasReported = true;
+    isPending = false;
+    lastReportMillis = millis();
+    reportCount++;
+}
+
+bool ReportPolicy::Update(const float& Value)
+{
+    lastValue = Value;
+    if (!ExceedsDeadband(Value))
+    {
+        //Back inside the deadband, a held value is no longer of interest
+        isPending = false;
+        suppressedCount++;
+        return false;
+    }
+    if (hasReported && minIntervalMs > 0 && millis() - lastReportMillis < minIntervalMs)
+    {
+        isPending = true;
+        suppressedCount++;
+        return false;
+    }
+    MarkReported(Value);
+    return true;
+}
+
+bool ReportPolicy::Poll(float& Value)
+{
+    if (!hasReported)
+    {
+        return false;
+    }
+    unsigned long elapsed = millis() - lastReportMillis;
+    if ((isPending && elapsed >= minIntervalMs) || (maxIntervalMs > 0 && elapsed >= maxIntervalMs))
+    {
+        MarkReported(lastValue);
+        Value = lastValue;
+        return true;
+    }
+    return false;
+}
+
+String ReportPolicy::ToString()
+{
+    return "Abs:" + String(absoluteDeadband) + " Rel:" + String(relativeDeadband) + " Hyst:" + String(hysteresis) +
+        " Min:" + String(minIntervalMs) + " Max:" + String(maxIntervalMs) + " Reported:" + String(reportCount) + " Suppressed:" + String(suppressedCount);
+}
@@ -0,0 +1,60 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// ReportPolicy.h
+
+#ifndef _REPORTPOLICY_h
+#define _REPORTPOLICY_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+//Decides when a changed value of a channel is passed to the callback. Defaults report every change.
+//  AbsoluteDeadband, RelativeDeadband: a change must exceed the larger of both (relative to the last reported value)
+//  Hysteresis: extra change needed to report in the opposite direction of the previous report
+//  MinIntervalMs: reports are at least this far apart, a change in between is held and reported when the interval ends
+//  MaxIntervalMs: the current value is reported again when nothing was reported this long (0 is never)
+class ReportPolicy
+{
+private:
+	float absoluteDeadband = 0;
+	float relativeDeadband = 0;
+	float hysteresis = 0;
+	unsigned long minIntervalMs = 0;
+	unsigned long maxIntervalMs = 0;
+	bool hasReported = false;
+	bool isPending = false;
+	int8_t lastDirection = 0;
+	float lastReported = 0;
+	float lastValue = 0;
+	unsigned long lastReportMillis = 0;
+	uint32_t reportCount = 0;
+	uint32_t suppressedCount = 0;
+	bool ExceedsDeadband(const float& Value);
+	void MarkReported(const float& Value);
+public:
+	ReportPolicy() {}
+	ReportPolicy(const float& AbsoluteDeadband, const float& RelativeDeadband, const float& Hysteresis, const unsigned long& MinIntervalMs, const unsigned long& MaxIntervalMs);
+	void Configure(const float& AbsoluteDeadband, const float& RelativeDeadband, const float& Hysteresis, const unsigned long& MinIntervalMs, const unsigned long& MaxIntervalMs);
+	bool Update(const float& Value); //New value of the channel, true when it is to be reported now
+	bool Poll(float& Value); //Held or periodic report that became due, call from Process()
+	void Reset() { hasReported = false; isPending = false; lastDirection = 0; } //Next value is reported
+	float GetLastReported() { return lastReported; }
+	uint32_t GetReportCount() { return reportCount; }
+	uint32_t GetSuppressedCount() { return suppressedCount; }
+	String ToString();
+};
+
+#endif
@@ -0,0 +1,109 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "RetryPolicy.h"
+
+RetryPolicy::RetryPolicy(const unsigned long& BaseDelayMs, const unsigned long& MaxDelayMs, const float& Jitter, const uint8_t& FailureThreshold, const unsigned long& OpenIntervalMs)
+{
+    Configure(BaseDelayMs, MaxDelayMs, Jitter, FailureThreshold, OpenIntervalMs);
+}
+
+void RetryPolicy::Configure(const unsigned long& BaseDelayMs, const unsigned long& MaxDelayMs, const float& Jitter, const uint8_t& FailureThreshold, const unsigned long& OpenIntervalMs)
+{
+    baseDelayMs = BaseDelayMs == 0 ? 1 : BaseDelayMs;
+    maxDelayMs = MaxDelayMs < baseDelayMs ? baseDelayMs : MaxDelayMs;
+    jitter = Jitter < 0 ? 0 : (Jitter > 1 ? 1 : Jitter);
+    failureThreshold = FailureThreshold;
+    openIntervalMs = OpenIntervalMs < maxDelayMs ? maxDelayMs : OpenIntervalMs;
+}
+
+uint32_t RetryPolicy::NextRandom()
+{
+    //xorshift32, good enough to spread retries
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 17;
+    randomState ^= randomState << 5;
+    return randomState;
+}
+
+unsigned long RetryPolicy::ApplyJitter(const unsigned long& DelayMs)
+{
+    unsigned long range = (unsigned long)((float)DelayMs * jitter);
+    if (range == 0)
+    {
+        return DelayMs;
+    }
+    return DelayMs - (NextRandom() % (range + 1));
+}
+
+void RetryPolicy::OnSuccess()
+{
+    state = RETRYPOLICY_STATE::RETRYPOLICY_STATE_CLOSED;
+    consecutiveFailures = 0;
+    lastDelayMs = 0;
+}
+
+void RetryPolicy::OnAttempt()
+{
+    if (state == RETRYPOLICY_STATE::RETRYPOLICY_STATE_OPEN)
+    {
+        state = RETRYPOLICY_STATE::RETRYPOLICY_STATE_HALF_OPEN;
+    }
+}
+
+unsigned long RetryPolicy::OnFailure()
+{
+    failureCount++;
+    if (consecutiveFailures < 0xFFFF)
+    {
+        consecutiveFailures++;
+    }
+
+    //A failed trial opens the circuit again, as does reaching the threshold
+    if (state == RETRYPOLICY_STATE::RETRYPOLICY_STATE_HALF_OPEN || state == RETRYPOLICY_STATE::RETRYPOLICY_STATE_OPEN ||
+        (failureThreshold > 0 && consecutiveFailures >= failureThreshold))
+    {
+        if (state != RETRYPOLICY_STATE::RETRYPOLICY_STATE_OPEN)
+        {
+            openCount++;
+        }
+        state = RETRYPOLICY_STATE::RETRYPOLICY_STATE_OPEN;
+        lastDelayMs = ApplyJitter(openIntervalMs);
+        return lastDelayMs;
+    }
+
+    unsigned long delayMs = baseDelayMs;
+    for (uint16_t i = 1; i < consecutiveFailures && delayMs < maxDelayMs; i++)
+    {
+        delayMs = delayMs > maxDelayMs / 2 ? maxDelayMs : delayMs * 2;
+    }
+    lastDelayMs = ApplyJitter(delayMs);
+    return lastDelayMs;
+}
+
+String RetryPolicy::GetStateString()
+{
+    switch (state)
+    {
+        case RETRYPOLICY_STATE::RETRYPOLICY_STATE_OPEN:
+            return F("open");
+        case RETRYPOLICY_STATE::RETRYPOLICY_STATE_HALF_OPEN:
+            return F("half-open");
+        default:
+            return F("closed");
+    }
+}
+
+String RetryPolicy::ToString()
+{
+    return GetStateString() + " Fail:" + String(consecutiveFailures) + " Delay:" + String(lastDelayMs) + " Failures:" + String(failureCount) + " Opened:" + String(openCount);
+}
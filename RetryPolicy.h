@@ -0,0 +1,74 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// RetryPolicy.h
+
+#ifndef _RETRYPOLICY_h
+#define _RETRYPOLICY_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+namespace RETRYPOLICY_STATEENUM
+{
+	enum RETRYPOLICY_STATE :uint8_t
+	{
+		RETRYPOLICY_STATE_CLOSED = 0, //Requests pass, failures back off
+		RETRYPOLICY_STATE_OPEN = 1, //Too many failures, wait the open interval
+		RETRYPOLICY_STATE_HALF_OPEN = 2, //One trial request after the open interval
+	};
+}
+typedef RETRYPOLICY_STATEENUM::RETRYPOLICY_STATE RETRYPOLICY_STATE;
+
+//Decides how long to wait before retrying a failed request, a circuit breaker on top of exponential backoff.
+//  BaseDelayMs: wait after the first failure, doubled for every next failure
+//  MaxDelayMs: cap of the backoff
+//  Jitter: fraction of the delay taken off at random (0..1), so stations do not retry in step
+//  FailureThreshold: consecutive failures that open the circuit (0 is never)
+//  OpenIntervalMs: wait while open, after it one trial request is made (half open)
+class RetryPolicy
+{
+private:
+	unsigned long baseDelayMs = 30000;
+	unsigned long maxDelayMs = 30000;
+	float jitter = 0;
+	uint8_t failureThreshold = 0;
+	unsigned long openIntervalMs = 0;
+	RETRYPOLICY_STATE state = RETRYPOLICY_STATE::RETRYPOLICY_STATE_CLOSED;
+	uint16_t consecutiveFailures = 0;
+	unsigned long lastDelayMs = 0;
+	uint32_t failureCount = 0;
+	uint32_t openCount = 0;
+	uint32_t randomState = 1;
+	uint32_t NextRandom();
+	unsigned long ApplyJitter(const unsigned long& DelayMs);
+public:
+	RetryPolicy() {}
+	RetryPolicy(const unsigned long& BaseDelayMs, const unsigned long& MaxDelayMs, const float& Jitter, const uint8_t& FailureThreshold, const unsigned long& OpenIntervalMs);
+	void Configure(const unsigned long& BaseDelayMs, const unsigned long& MaxDelayMs, const float& Jitter, const uint8_t& FailureThreshold, const unsigned long& OpenIntervalMs);
+	void Seed(const uint32_t& Seed) { randomState = Seed == 0 ? 1 : Seed; }
+	void OnSuccess();
+	unsigned long OnFailure(); //Returns the delay before the next attempt
+	void OnAttempt(); //A request is made, an open circuit becomes half open
+	RETRYPOLICY_STATE GetState() { return state; }
+	uint16_t GetConsecutiveFailures() { return consecutiveFailures; }
+	unsigned long GetLastDelay() { return lastDelayMs; }
+	uint32_t GetFailureCount() { return failureCount; }
+	uint32_t GetOpenCount() { return openCount; }
+	String GetStateString();
+	String ToString();
+};
+
+#endif
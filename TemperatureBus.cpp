@@ -0,0 +1,409 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "TemperatureBus.h"
+
+TemperatureBusBitBang::~TemperatureBusBitBang()
+{
+    if (oTemperatureSensor != NULL)
+    {
+        delete oTemperatureSensor;
+        oTemperatureSensor = NULL;
+    }
+    if (oneWireBus != NULL)
+    {
+        delete oneWireBus;
+        oneWireBus = NULL;
+    }
+}
+
+bool TemperatureBusBitBang::Begin(const uint8_t& Pin)
+{
+    oneWireBus = new OneWire(Pin);
+    oTemperatureSensor = new DallasTemperature(oneWireBus);
+    oTemperatureSensor->begin();
+    oTemperatureSensor->setWaitForConversion(false);
+    resolution = oTemperatureSensor->getResolution();
+    return true;
+}
+
+void TemperatureBusBitBang::ResetSearch()
+{
+    oneWireBus->reset_search();
+}
+
+bool TemperatureBusBitBang::Search(DeviceAddress& Address)
+{
+    while (oneWireBus->search(Address))
+    {
+        if (OneWire::crc8(Address, 7) == Address[7])
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void TemperatureBusBitBang::RequestTemperatures()
+{
+    oTemperatureSensor->requestTemperatures();
+}
+
+bool TemperatureBusBitBang::IsConversionComplete()
+{
+    return oTemperatureSensor->isConversionComplete();
+}
+
+float TemperatureBusBitBang::GetTempC(const DeviceAddress& Address)
+{
+    return oTemperatureSensor->getTempC(Address);
+}
+
+bool TemperatureBusBitBang::SetResolution(const DeviceAddress& Address, const uint8_t& Resolution)
+{
+    //Without reading all probes back for the bus wide resolution
+    if (!oTemperatureSensor->setResolution(Address, Resolution, true))
+    {
+        return false;
+    }
+    resolution = Resolution;
+    return true;
+}
+
+uint8_t TemperatureBusBitBang::GetResolution()
+{
+    return resolution;
+}
+
+uint16_t TemperatureBusBitBang::GetConversionMillis()
+{
+    return oTemperatureSensor->millisToWaitForConversion(resolution);
+}
+
+#ifdef ESP32
+TemperatureBusRMT::~TemperatureBusRMT()
+{
+    if (isInstalled)
+    {
+        rmt_rx_stop(TEMPERATUREBUS_RMT_RX_CHANNEL);
+        rmt_driver_uninstall(TEMPERATUREBUS_RMT_RX_CHANNEL);
+        rmt_driver_uninstall(TEMPERATUREBUS_RMT_TX_CHANNEL);
+    }
+}
+
+bool TemperatureBusRMT::Begin(const uint8_t& Pin)
+{
+    //1 tick per microsecond, the line is released (high) when idle
+    rmt_config_t txConfig = {};
+    txConfig.rmt_mode = RMT_MODE_TX;
+    txConfig.channel = TEMPERATUREBUS_RMT_TX_CHANNEL;
+    txConfig.gpio_num = (gpio_num_t)Pin;
+    txConfig.clk_div = 80;
+    txConfig.mem_block_num = 1;
+    txConfig.tx_config.idle_level = RMT_IDLE_LEVEL_HIGH;
+    txConfig.tx_config.idle_output_en = true;
+    txConfig.tx_config.carrier_en = false;
+    txConfig.tx_config.loop_en = false;
+    if (rmt_config(&txConfig) != ESP_OK || rmt_driver_install(TEMPERATUREBUS_RMT_TX_CHANNEL, 0, 0) != ESP_OK)
+    {
+        return false;
+    }
+
+    rmt_config_t rxConfig = {};
+    rxConfig.rmt_mode = RMT_MODE_RX;
+    rxConfig.channel = TEMPERATUREBUS_RMT_RX_CHANNEL;
+    rxConfig.gpio_num = (gpio_num_t)Pin;
+    rxConfig.clk_div = 80;
+    rxConfig.mem_block_num = 1;
+    rxConfig.rx_config.filter_en = true;
+    rxConfig.rx_config.filter_ticks_thresh = TEMPERATUREBUS_RMT_RX_FILTER;
+    rxConfig.rx_config.idle_threshold = TEMPERATUREBUS_SLOT_IDLE_US;
+    if (rmt_config(&rxConfig) != ESP_OK || rmt_driver_install(TEMPERATUREBUS_RMT_RX_CHANNEL, TEMPERATUREBUS_RMT_RX_BUFFER, 0) != ESP_OK)
+    {
+        rmt_driver_uninstall(TEMPERATUREBUS_RMT_TX_CHANNEL);
+        return false;
+    }
+    if (rmt_get_ringbuf_handle(TEMPERATUREBUS_RMT_RX_CHANNEL, &rxBuffer) != ESP_OK)
+    {
+        rmt_driver_uninstall(TEMPERATUREBUS_RMT_RX_CHANNEL);
+        rmt_driver_uninstall(TEMPERATUREBUS_RMT_TX_CHANNEL);
+        return false;
+    }
+    isInstalled = true;
+
+    //Open drain with pull-up, the receive channel sees the bus including the transmitted levels
+    gpio_set_pull_mode((gpio_num_t)Pin, GPIO_PULLUP_ONLY);
+    gpio_set_direction((gpio_num_t)Pin, GPIO_MODE_INPUT_OUTPUT_OD);
+    esp_rom_gpio_connect_out_signal(Pin, RMT_SIG_OUT0_IDX + TEMPERATUREBUS_RMT_TX_CHANNEL, false, false);
+    esp_rom_gpio_connect_in_signal(Pin, RMT_SIG_IN0_IDX + TEMPERATUREBUS_RMT_RX_CHANNEL, false);
+    //No bus search here, the probes are enumerated and configured one per TemperatureSensor::Process()
+    return true;
+}
+
+bool TemperatureBusRMT::ResetPulse()
+{
+    //The reset pulse is longer than the slot idle threshold, the receiver would end the frame halfway
+    rmt_item32_t item;
+    item.level0 = 0;
+    item.duration0 = TEMPERATUREBUS_RESET_US;
+    item.level1 = 1;
+    item.duration1 = TEMPERATUREBUS_RESET_RELEASE_US;
+    rmt_set_rx_idle_thresh(TEMPERATUREBUS_RMT_RX_CHANNEL, TEMPERATUREBUS_RESET_IDLE_US);
+    rmt_rx_start(TEMPERATUREBUS_RMT_RX_CHANNEL, true);
+    rmt_write_items(TEMPERATUREBUS_RMT_TX_CHANNEL, &item, 1, true);
+
+    //Presence: a low level after the reset pulse
+    bool presence = false;
+    size_t rxSize = 0;
+    rmt_item32_t* rxItems = (rmt_item32_t*)xRingbufferReceive(rxBuffer, &rxSize, pdMS_TO_TICKS(TEMPERATUREBUS_RMT_TIMEOUT));
+    if (rxItems != NULL)
+    {
+        uint8_t lowCount = 0;
+        for (size_t i = 0; i < rxSize / sizeof(rmt_item32_t); i++)
+        {
+            lowCount += (rxItems[i].level0 == 0 && rxItems[i].duration0 > 0) ? 1 : 0;
+            lowCount += (rxItems[i].level1 == 0 && rxItems[i].duration1 > 0) ? 1 : 0;
+        }
+        presence = lowCount >= 2;
+        vRingbufferReturnItem(rxBuffer, rxItems);
+    }
+    rmt_rx_stop(TEMPERATUREBUS_RMT_RX_CHANNEL);
+    rmt_set_rx_idle_thresh(TEMPERATUREBUS_RMT_RX_CHANNEL, TEMPERATUREBUS_SLOT_IDLE_US);
+    return presence;
+}
+
+uint8_t TemperatureBusRMT::Slots(const uint8_t& Value, const uint8_t& Count)
+{
+    //Count time slots, least significant bit first. A 1 is a write 1 or read slot, the bits read back are returned:
+    //a write 0 slot reads as 0, a write 1 slot as the level the probes leave at the sample point.
+    rmt_item32_t items[8];
+    for (uint8_t i = 0; i < Count; i++)
+    {
+        bool bit = (Value >> i) & 0x01;
+        items[i].level0 = 0;
+        items[i].duration0 = bit ? TEMPERATUREBUS_WRITE1_LOW_US : TEMPERATUREBUS_WRITE0_LOW_US;
+        items[i].level1 = 1;
+        items[i].duration1 = TEMPERATUREBUS_SLOT_US - items[i].duration0;
+    }
+    rmt_rx_start(TEMPERATUREBUS_RMT_RX_CHANNEL, true);
+    rmt_write_items(TEMPERATUREBUS_RMT_TX_CHANNEL, items, Count, true);
+
+    uint8_t result = 0;
+    size_t rxSize = 0;
+    rmt_item32_t* rxItems = (rmt_item32_t*)xRingbufferReceive(rxBuffer, &rxSize, pdMS_TO_TICKS(TEMPERATUREBUS_RMT_TIMEOUT));
+    if (rxItems != NULL)
+    {
+        //One low level per slot
+        uint8_t slot = 0;
+        for (size_t i = 0; i < rxSize / sizeof(rmt_item32_t) && slot < Count; i++)
+        {
+            if (rxItems[i].level0 == 0 && rxItems[i].duration0 > 0)
+            {
+                result |= (rxItems[i].duration0 <= TEMPERATUREBUS_READ_SAMPLE_US) ? (1 << slot) : 0;
+                slot++;
+            }
+            if (slot < Count && rxItems[i].level1 == 0 && rxItems[i].duration1 > 0)
+            {
+                result |= (rxItems[i].duration1 <= TEMPERATUREBUS_READ_SAMPLE_US) ? (1 << slot) : 0;
+                slot++;
+            }
+        }
+        vRingbufferReturnItem(rxBuffer, rxItems);
+    }
+    rmt_rx_stop(TEMPERATUREBUS_RMT_RX_CHANNEL);
+    return result;
+}
+
+uint8_t TemperatureBusRMT::Crc8(const uint8_t* Data, const uint8_t& Length)
+{
+    //Dallas/Maxim CRC, x^8 + x^5 + x^4 + 1
+    uint8_t crc = 0;
+    for (uint8_t i = 0; i < Length; i++)
+    {
+        uint8_t inbyte = Data[i];
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            uint8_t mix = (crc ^ inbyte) & 0x01;
+            crc >>= 1;
+            if (mix)
+            {
+                crc ^= 0x8C;
+            }
+            inbyte >>= 1;
+        }
+    }
+    return crc;
+}
+
+void TemperatureBusRMT::ResetSearch()
+{
+    lastDiscrepancy = 0;
+    lastDevice = false;
+    memset(romNo, 0, sizeof(romNo));
+}
+
+bool TemperatureBusRMT::Search(DeviceAddress& Address)
+{
+    //Maxim application note 187, the two read slots of a bit in one transfer
+    while (!lastDevice)
+    {
+        if (!ResetPulse())
+        {
+            ResetSearch();
+            return false;
+        }
+        Slots(0xF0, 8);
+        uint8_t lastZero = 0;
+        for (uint8_t bitNumber = 1; bitNumber <= 64; bitNumber++)
+        {
+            uint8_t bits = Slots(0x03, 2);
+            bool idBit = bits & 0x01;
+            bool cmpIdBit = bits & 0x02;
+            if (idBit && cmpIdBit)
+            {
+                //No probe answered
+                ResetSearch();
+                return false;
+            }
+            uint8_t byteNumber = (bitNumber - 1) / 8;
+            uint8_t byteMask = 1 << ((bitNumber - 1) % 8);
+            bool direction;
+            if (idBit != cmpIdBit)
+            {
+                direction = idBit;
+            }
+            else
+            {
+                direction = (bitNumber < lastDiscrepancy) ? (romNo[byteNumber] & byteMask) != 0 : (bitNumber == lastDiscrepancy);
+                if (!direction)
+                {
+                    lastZero = bitNumber;
+                }
+            }
+            romNo[byteNumber] = direction ? (romNo[byteNumber] | byteMask) : (romNo[byteNumber] & ~byteMask);
+            Slots(direction ? 0x01 : 0x00, 1);
+        }
+        lastDiscrepancy = lastZero;
+        lastDevice = (lastZero == 0);
+        if (romNo[0] != 0 && Crc8(romNo, 7) == romNo[7])
+        {
+            memcpy(Address, romNo, sizeof(DeviceAddress));
+            return true;
+        }
+    }
+    return false;
+}
+
+void TemperatureBusRMT::RequestTemperatures()
+{
+    //Skip ROM, convert T
+    if (ResetPulse())
+    {
+        Slots(0xCC, 8);
+        Slots(0x44, 8);
+    }
+}
+
+bool TemperatureBusRMT::IsConversionComplete()
+{
+    //A read slot, the probes hold it low while converting
+    return Slots(0x01, 1) == 0x01;
+}
+
+bool TemperatureBusRMT::ReadScratchpad(const DeviceAddress& Address, uint8_t* Scratchpad)
+{
+    if (!ResetPulse())
+    {
+        return false;
+    }
+    //Match ROM, read scratchpad
+    Slots(0x55, 8);
+    for (uint8_t i = 0; i < sizeof(DeviceAddress); i++)
+    {
+        Slots(Address[i], 8);
+    }
+    Slots(0xBE, 8);
+    bool allZeros = true;
+    for (uint8_t i = 0; i < 9; i++)
+    {
+        Scratchpad[i] = Slots(0xFF, 8);
+        allZeros = allZeros && Scratchpad[i] == 0;
+    }
+    return !allZeros && Crc8(Scratchpad, 8) == Scratchpad[8];
+}
+
+void TemperatureBusRMT::WriteScratchpad(const DeviceAddress& Address, const uint8_t& High, const uint8_t& Low, const uint8_t& Configuration)
+{
+    if (!ResetPulse())
+    {
+        return;
+    }
+    //Match ROM, write scratchpad: TH, TL and the configuration register
+    Slots(0x55, 8);
+    for (uint8_t i = 0; i < sizeof(DeviceAddress); i++)
+    {
+        Slots(Address[i], 8);
+    }
+    Slots(0x4E, 8);
+    Slots(High, 8);
+    Slots(Low, 8);
+    Slots(Configuration, 8);
+}
+
+bool TemperatureBusRMT::SetResolution(const DeviceAddress& Address, const uint8_t& Resolution)
+{
+    //The alarm thresholds in the scratchpad are kept
+    uint8_t scratchpad[9];
+    if (Resolution < 9 || Resolution > 12 || !ReadScratchpad(Address, scratchpad))
+    {
+        return false;
+    }
+    WriteScratchpad(Address, scratchpad[2], scratchpad[3], (uint8_t)(((Resolution - 9) << 5) | 0x1F));
+    resolution = Resolution;
+    return true;
+}
+
+uint8_t TemperatureBusRMT::GetResolution()
+{
+    return resolution;
+}
+
+float TemperatureBusRMT::GetTempC(const DeviceAddress& Address)
+{
+    uint8_t scratchpad[9];
+    if (!ReadScratchpad(Address, scratchpad))
+    {
+        return DEVICE_DISCONNECTED_C;
+    }
+    //1/16 degree steps, the bits below the resolution of the probe are undefined
+    uint8_t probeResolution = ((scratchpad[4] >> 5) & 0x03) + 9;
+    int16_t raw = (int16_t)(((uint16_t)scratchpad[1] << 8) | scratchpad[0]);
+    raw &= (int16_t)~((1 << (12 - probeResolution)) - 1);
+    return (float)raw * 0.0625f;
+}
+
+uint16_t TemperatureBusRMT::GetConversionMillis()
+{
+    //Datasheet maximum: 93.75ms at 9 bits, doubling per bit
+    switch (resolution)
+    {
+    case 9:
+        return 94;
+    case 10:
+        return 188;
+    case 11:
+        return 375;
+    default:
+        return 750;
+    }
+}
+#endif
@@ -0,0 +1,131 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// TemperatureBus.h
+
+#ifndef _TEMPERATUREBUS_h
+#define _TEMPERATUREBUS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include <OneWire.h>
+#include <DallasTemperature.h>
+
+#ifdef ESP32
+	#include "driver/rmt.h"
+	#include "driver/gpio.h"
+	#include "esp_rom_gpio.h"
+	#include "soc/gpio_sig_map.h"
+#endif
+
+#define TEMPERATUREBUS_RMT_TX_CHANNEL RMT_CHANNEL_0
+#define TEMPERATUREBUS_RMT_RX_CHANNEL RMT_CHANNEL_1
+#define TEMPERATUREBUS_RMT_RX_BUFFER 512 //Bytes in the receive ring buffer
+#define TEMPERATUREBUS_RMT_RX_FILTER 30 //Glitches shorter than this many APB clock ticks (80MHz) are ignored
+#define TEMPERATUREBUS_RMT_TIMEOUT 2 //ms to wait for the received frame after the transmission, it ends TEMPERATUREBUS_SLOT_IDLE_US after the last edge
+#define TEMPERATUREBUS_RESET_US 480 //Reset pulse, followed by the presence pulse of the probes
+#define TEMPERATUREBUS_RESET_RELEASE_US 70
+#define TEMPERATUREBUS_RESET_IDLE_US 540 //Receive idle threshold during a reset, longer than the reset pulse
+#define TEMPERATUREBUS_SLOT_IDLE_US 80 //Receive idle threshold during time slots, longer than any level in a slot
+#define TEMPERATUREBUS_SLOT_US 70 //Time slot including the recovery time
+#define TEMPERATUREBUS_WRITE1_LOW_US 6 //Write 1 and read slots
+#define TEMPERATUREBUS_WRITE0_LOW_US 60
+#define TEMPERATUREBUS_READ_SAMPLE_US 15 //A read slot held low for longer than this by a probe is a 0
+
+namespace TEMPERATUREBUS_TYPEENUM
+{
+	enum TEMPERATUREBUS_TYPE :uint8_t
+	{
+		TEMPERATUREBUS_TYPE_BITBANG = 0,
+		TEMPERATUREBUS_TYPE_RMT = 1,
+	};
+}
+typedef TEMPERATUREBUS_TYPEENUM::TEMPERATUREBUS_TYPE TEMPERATUREBUS_TYPE;
+
+//OneWire transport to the DS18B20 probes. Search() enumerates the ROM codes one per call after ResetSearch(),
+//RequestTemperatures() starts a conversion on all probes, IsConversionComplete() reads a time slot: 1 once all
+//probes are done (not with parasite power). GetTempC() reads one probe by its ROM code. SetResolution() configures
+//one probe by its ROM code, GetConversionMillis() is the datasheet conversion time of the last resolution set.
+class TemperatureBus
+{
+public:
+	virtual ~TemperatureBus() {}
+	virtual bool Begin(const uint8_t& Pin) = 0;
+	virtual void ResetSearch() = 0;
+	virtual bool Search(DeviceAddress& Address) = 0;
+	virtual void RequestTemperatures() = 0;
+	virtual bool IsConversionComplete() = 0;
+	virtual float GetTempC(const DeviceAddress& Address) = 0;
+	virtual bool SetResolution(const DeviceAddress& Address, const uint8_t& Resolution) = 0;
+	virtual uint8_t GetResolution() = 0;
+	virtual uint16_t GetConversionMillis() = 0;
+	virtual TEMPERATUREBUS_TYPE GetType() = 0;
+};
+
+//OneWire and DallasTemperature libraries. The time slots are bit banged with interrupts disabled, up to 70us at a time.
+class TemperatureBusBitBang : public TemperatureBus
+{
+private:
+	OneWire* oneWireBus = NULL;
+	DallasTemperature* oTemperatureSensor = NULL;
+	uint8_t resolution = 12;
+public:
+	~TemperatureBusBitBang();
+	bool Begin(const uint8_t& Pin);
+	void ResetSearch();
+	bool Search(DeviceAddress& Address);
+	void RequestTemperatures();
+	bool IsConversionComplete();
+	float GetTempC(const DeviceAddress& Address);
+	bool SetResolution(const DeviceAddress& Address, const uint8_t& Resolution);
+	uint8_t GetResolution();
+	uint16_t GetConversionMillis();
+	TEMPERATUREBUS_TYPE GetType() { return TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_BITBANG; }
+};
+
+#ifdef ESP32
+//RMT peripheral: a transmit and a receive channel on the open drain pin. The peripheral times the slots and
+//records the bus levels, interrupts stay enabled. Up to 8 slots per transfer.
+class TemperatureBusRMT : public TemperatureBus
+{
+private:
+	bool isInstalled = false;
+	RingbufHandle_t rxBuffer = NULL;
+	uint8_t resolution = 12; //Longest conversion until the probes are configured
+	uint8_t romNo[8];
+	uint8_t lastDiscrepancy = 0;
+	bool lastDevice = false;
+	bool ResetPulse();
+	uint8_t Slots(const uint8_t& Value, const uint8_t& Count);
+	bool ReadScratchpad(const DeviceAddress& Address, uint8_t* Scratchpad);
+	void WriteScratchpad(const DeviceAddress& Address, const uint8_t& High, const uint8_t& Low, const uint8_t& Configuration);
+	static uint8_t Crc8(const uint8_t* Data, const uint8_t& Length);
+public:
+	~TemperatureBusRMT();
+	bool Begin(const uint8_t& Pin);
+	void ResetSearch();
+	bool Search(DeviceAddress& Address);
+	void RequestTemperatures();
+	bool IsConversionComplete();
+	float GetTempC(const DeviceAddress& Address);
+	bool SetResolution(const DeviceAddress& Address, const uint8_t& Resolution);
+	uint8_t GetResolution();
+	uint16_t GetConversionMillis();
+	TEMPERATUREBUS_TYPE GetType() { return TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT; }
+};
+#endif
+
+#endif
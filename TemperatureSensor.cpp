@@ -13,92 +13,482 @@
 
 #include "TemperatureSensor.h"
 
-TemperatureSensor::TemperatureSensor(const uint8_t &SensorPin)
+static const TemperatureProfileSettings temperatureProfiles[TEMPERATURE_PROFILE_COUNT] =
+{
+	{ 9, 8, 10005 },
+	{ 10, 6, 20005 },
+	{ 11, 5, 30005 },
+	{ 12, 5, TEMPERATURE_REFRESH_INTERVAL },
+};
+
+TemperatureSensor::TemperatureSensor(const uint8_t &SensorPin, const TEMPERATUREBUS_TYPE BusType)
 {
 	//this->UsedSensorPin = SensorPin;
-	oneWireBus = new OneWire(SensorPin);
-	oTemperatureSensor = new DallasTemperature(oneWireBus);
-	oTemperatureSensor->begin();
+#ifdef ESP32
+	if (BusType == TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT)
+	{
+		temperatureBus = new TemperatureBusRMT();
+		if (!temperatureBus->Begin(SensorPin))
+		{
+			//Fall back to the bit banged bus when the RMT channels can not be set up
+			delete temperatureBus;
+			temperatureBus = NULL;
+		}
+	}
+#endif
+	if (temperatureBus == NULL)
+	{
+		temperatureBus = new TemperatureBusBitBang();
+		temperatureBus->Begin(SensorPin);
+	}
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+	{
+		probes[p].inUse = false;
+		probes[p].present = false;
+		probes[p].temperature = -50; //Initial temperature to force update
+	}
+	//The bus is enumerated by Process(), one ROM per call. The probes found are configured after the scan.
+	StartScan();
+	previousScanMillis = millis();
 	previousWeatherInfoCollectMillis = millis() - (TEMPERATURE_REFRESH_INTERVAL / 2);
 }
 
 TemperatureSensor::~TemperatureSensor()
 {
-	if (oTemperatureSensor != NULL)
+	if (temperatureBus != NULL)
 	{
-		delete oTemperatureSensor;
-		oTemperatureSensor = NULL;
+		delete temperatureBus;
+		temperatureBus = NULL;
+	}
+}
+
+void TemperatureSensor::Process()
+{
+	switch (state)
+	{
+	case TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_IDLE:
+		if (millis() - previousWeatherInfoCollectMillis >= GetProfileSettings(profile).refreshInterval)
+		{
+			if (millis() - previousScanMillis >= TEMPERATURE_RESCAN_INTERVAL)
+			{
+				//The conversion follows once the scan is done
+				StartScan();
+				break;
+			}
+			if (isResolutionPending)
+			{
+				//The conversion follows once the probes are configured, a profile change meanwhile configures again
+				isResolutionPending = false;
+				stateIndex = 0;
+				state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_CONFIGURING;
+				break;
+			}
+			previousWeatherInfoCollectMillis = millis();
+			StartConversion();
+		}
+		break;
+	case TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_SCANNING:
+		if (!ScanNext())
+		{
+			//A probe that joined the bus still has the resolution of its EEPROM
+			for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+			{
+				if (probes[p].present && !(presentBeforeScan & (1 << p)))
+				{
+					isResolutionPending = true;
+				}
+			}
+			previousScanMillis = millis();
+			state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_IDLE;
+		}
+		break;
+	case TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_CONFIGURING:
+		while (stateIndex < TEMPERATURE_MAX_PROBES && !probes[stateIndex].present)
+		{
+			stateIndex++;
+		}
+		if (stateIndex < TEMPERATURE_MAX_PROBES)
+		{
+			temperatureBus->SetResolution(probes[stateIndex++].address, GetProfileSettings(profile).resolution);
+		}
+		if (stateIndex >= TEMPERATURE_MAX_PROBES)
+		{
+			state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_IDLE;
+		}
+		break;
+	case TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_CONVERTING:
+		PollConversion();
+		break;
+	case TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_READING:
+		//Channel 0 is always read, without a probe it reports as a broken sensor
+		while (stateIndex < TEMPERATURE_MAX_PROBES && stateIndex != 0 && !probes[stateIndex].present)
+		{
+			stateIndex++;
+		}
+		if (stateIndex < TEMPERATURE_MAX_PROBES)
+		{
+			ReadProbe(stateIndex++);
+		}
+		if (stateIndex >= TEMPERATURE_MAX_PROBES)
+		{
+			state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_IDLE;
+		}
+		break;
 	}
-	if (oneWireBus != NULL)
+	float heldTemperature;
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
 	{
-		delete oneWireBus;
-		oneWireBus = NULL;
+		if ((p == 0 || probes[p].inUse) && probes[p].reportPolicy.Poll(heldTemperature))
+		{
+			Report(p, heldTemperature);
+		}
 	}
 }
 
-void TemperatureSensor::Process()
+void TemperatureSensor::PollConversion()
 {
-	if (millis() - previousWeatherInfoCollectMillis >= (TEMPERATURE_REFRESH_INTERVAL))
+	if (state != TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_CONVERTING || millis() - previousConversionPollMillis < TEMPERATURE_CONVERSION_POLL_INTERVAL)
 	{
-		previousWeatherInfoCollectMillis = millis();
-		oTemperatureSensor->requestTemperatures(); // Send the command to get temperature readings
-		float tTemperatureCoutside = oTemperatureSensor->getTempCByIndex(0);
+		return;
+	}
+	//Done when the probes release the read slot, or after the datasheet time (parasite power)
+	previousConversionPollMillis = millis();
+	unsigned long elapsedMillis = millis() - conversionStartMillis;
+	if (temperatureBus->IsConversionComplete())
+	{
+		//Only a completion seen on the bus is a measurement, accurate to the poll interval
+		measuredConversionMillis[profile] = elapsedMillis;
+	}
+	else if (elapsedMillis < conversionMillis)
+	{
+		return;
+	}
+	stateIndex = 0;
+	state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_READING;
+}
+
+void TemperatureSensor::StartConversion()
+{
+	//Skip ROM convert command to all probes, the loop keeps running while they convert
+	temperatureBus->RequestTemperatures();
+	conversionStartMillis = millis();
+	previousConversionPollMillis = conversionStartMillis;
+	conversionMillis = temperatureBus->GetConversionMillis() + TEMPERATURE_CONVERSION_MARGIN;
+	state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_CONVERTING;
+}
+
+void TemperatureSensor::ReadProbe(const uint8_t& Probe)
+{
+	TemperatureProbe& probe = probes[Probe];
+	//Read by the cached ROM code, no bus search
+	float tTemperatureCoutside = probe.present ? temperatureBus->GetTempC(probe.address) : DEVICE_DISCONNECTED_C;
+
+	if (tTemperatureCoutside < -40 || tTemperatureCoutside > 60)
+	{
+		if (probe.present && tTemperatureCoutside == DEVICE_DISCONNECTED_C)
+		{
+			//Probe did not answer, enumerate the bus before the next conversion
+			previousScanMillis = millis() - TEMPERATURE_RESCAN_INTERVAL;
+		}
+		if (probe.temperature < -40)
+		{
+			//Never had a correct reading, sensor broken?
+			//Serial.println("Sensor Error?");
+			tTemperatureCoutside = 0;
+		}
+		else
+		{
+			tTemperatureCoutside = probe.temperature;
+		}			
+	}
+	float temperatureCoutside = shiftTemperatureArray(probe, tTemperatureCoutside);
+	SetTemperature(Probe, temperatureCoutside);
+}
+
+void TemperatureSensor::StartScan()
+{
+	presentBeforeScan = 0;
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+	{
+		presentBeforeScan |= probes[p].present ? (1 << p) : 0;
+		probes[p].present = false;
+	}
+	stateIndex = 0;
+	temperatureBus->ResetSearch();
+	state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_SCANNING;
+}
+
+bool TemperatureSensor::ScanNext()
+{
+	if (stateIndex >= TEMPERATURE_MAX_PROBES)
+	{
+		return false;
+	}
+	//Continues the search of the previous call, one ROM per call
+	DeviceAddress address;
+	if (!temperatureBus->Search(address))
+	{
+		return false;
+	}
+	AddProbe(address);
+	stateIndex++;
+	return true;
+}
+
+void TemperatureSensor::AddProbe(const DeviceAddress& Address)
+{
+	int8_t freeSlot = -1;
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+	{
+		if (probes[p].inUse && memcmp(probes[p].address, Address, sizeof(DeviceAddress)) == 0)
+		{
+			probes[p].present = true;
+			return;
+		}
+		if (!probes[p].inUse && freeSlot < 0)
+		{
+			freeSlot = p;
+		}
+	}
+	if (freeSlot < 0)
+	{
+		//More probes than channels
+		return;
+	}
+	memcpy(probes[freeSlot].address, Address, sizeof(DeviceAddress));
+	probes[freeSlot].inUse = true;
+	probes[freeSlot].present = true;
+	isProbeMapChanged = true;
+}
 
-		if (tTemperatureCoutside < -40 || tTemperatureCoutside > 60)
+void TemperatureSensor::SetProfile(const TEMPERATURE_PROFILE& Profile)
+{
+	if (Profile >= TEMPERATURE_PROFILE_COUNT)
+	{
+		return;
+	}
+	if (Profile != profile)
+	{
+		profile = Profile;
+		//Averaging restarts at the current temperature, with the depth of the profile
+		for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
 		{
-			if (MessuredTemperature < -40)
+			if (probes[p].temperature >= -40)
 			{
-				//Never had a correct reading, sensor broken?
-				//Serial.println("Sensor Error?");
-				tTemperatureCoutside = 0;
+				for (uint8_t i = 0; i < TEMPERATURE_AVERAGE_ARRAY_SIZE; i++)
+				{
+					probes[p].temperatureArray[i] = probes[p].temperature;
+				}
 			}
-			else
-			{
-				tTemperatureCoutside = MessuredTemperature;
-			}			
 		}
-		float temperatureCoutside = shiftTemperatureArray(tTemperatureCoutside);
-		SetTemperature(temperatureCoutside);
 	}
+	//Written by Process(), the bus may be busy now
+	isResolutionPending = isResolutionPending || temperatureBus->GetResolution() != GetProfileSettings(profile).resolution;
+}
+
+const TemperatureProfileSettings& TemperatureSensor::GetProfileSettings(const TEMPERATURE_PROFILE& Profile)
+{
+	return temperatureProfiles[Profile < TEMPERATURE_PROFILE_COUNT ? Profile : TEMPERATURE_PROFILE::TEMPERATURE_PROFILE_12BIT];
+}
+
+unsigned long TemperatureSensor::GetMeasuredConversionMillis(const TEMPERATURE_PROFILE& Profile)
+{
+	return Profile < TEMPERATURE_PROFILE_COUNT ? measuredConversionMillis[Profile] : 0;
+}
+
+String TemperatureSensor::GetProfileString()
+{
+	const TemperatureProfileSettings& settings = GetProfileSettings(profile);
+	return String(settings.resolution) + " bit, " + String(settings.averageDepth) + " averaged, every " + String(settings.refreshInterval) + "ms";
 }
 
 float TemperatureSensor::GetTemperature()
 {
-	return MessuredTemperature;
+	return probes[0].temperature;
+}
+
+float TemperatureSensor::GetProbeTemperature(const uint8_t& Probe)
+{
+	if (Probe >= TEMPERATURE_MAX_PROBES)
+	{
+		return DEVICE_DISCONNECTED_C;
+	}
+	return probes[Probe].temperature;
+}
+
+uint8_t TemperatureSensor::GetProbeCount()
+{
+	uint8_t count = 0;
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+	{
+		if (probes[p].inUse)
+		{
+			count = p + 1;
+		}
+	}
+	return count;
 }
 
-float TemperatureSensor::shiftTemperatureArray(const float& newValue)
+bool TemperatureSensor::IsProbePresent(const uint8_t& Probe)
 {
-	if (MessuredTemperature < -40) //Initial
+	return Probe < TEMPERATURE_MAX_PROBES && probes[Probe].present;
+}
+
+String TemperatureSensor::GetProbeAddress(const uint8_t& Probe)
+{
+	if (Probe >= TEMPERATURE_MAX_PROBES || !probes[Probe].inUse)
+	{
+		return "";
+	}
+	const char hex[] = "0123456789ABCDEF";
+	char text[sizeof(DeviceAddress) * 2 + 1];
+	for (uint8_t i = 0; i < sizeof(DeviceAddress); i++)
+	{
+		text[i * 2] = hex[probes[Probe].address[i] >> 4];
+		text[i * 2 + 1] = hex[probes[Probe].address[i] & 0x0F];
+	}
+	text[sizeof(DeviceAddress) * 2] = 0;
+	return String(text);
+}
+
+bool TemperatureSensor::SetProbeMap(const char* ProbeMap)
+{
+	if (ProbeMap == NULL)
+	{
+		return false;
+	}
+	//"ROM,ROM,..." by channel, an empty entry leaves the channel free
+	DeviceAddress addresses[TEMPERATURE_MAX_PROBES];
+	uint8_t assigned = 0; //Bit per channel
+	const char* text = ProbeMap;
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES && *text != 0; p++)
+	{
+		if (*text != ',')
+		{
+			for (uint8_t i = 0; i < sizeof(DeviceAddress); i++)
+			{
+				int8_t high = hexNibble(*text++);
+				int8_t low = high < 0 ? -1 : hexNibble(*text++);
+				if (low < 0)
+				{
+					return false;
+				}
+				addresses[p][i] = (uint8_t)((high << 4) | low);
+			}
+			assigned |= 1 << p;
+		}
+		if (*text == ',')
+		{
+			text++;
+		}
+		else if (*text != 0)
+		{
+			return false;
+		}
+	}
+	if (*text != 0)
+	{
+		//More channels than TEMPERATURE_MAX_PROBES
+		return false;
+	}
+	for (uint8_t p = 0; p < TEMPERATURE_MAX_PROBES; p++)
+	{
+		probes[p].inUse = (assigned & (1 << p)) != 0;
+		probes[p].present = false;
+		probes[p].temperature = -50; //Initial temperature to force update
+		if (probes[p].inUse)
+		{
+			memcpy(probes[p].address, addresses[p], sizeof(DeviceAddress));
+		}
+	}
+	//Probes not in the map get the free channels
+	isProbeMapChanged = false;
+	StartScan();
+	previousScanMillis = millis();
+	return true;
+}
+
+String TemperatureSensor::GetProbeMap()
+{
+	String probeMap;
+	probeMap.reserve(TEMPERATURE_PROBEMAP_FIELD_LEN);
+	uint8_t probeCount = GetProbeCount();
+	for (uint8_t p = 0; p < probeCount; p++)
+	{
+		if (p > 0)
+		{
+			probeMap += ',';
+		}
+		probeMap += GetProbeAddress(p);
+	}
+	isProbeMapChanged = false;
+	return probeMap;
+}
+
+int8_t TemperatureSensor::hexNibble(const char& Hex)
+{
+	if (Hex >= '0' && Hex <= '9')
+	{
+		return Hex - '0';
+	}
+	if (Hex >= 'A' && Hex <= 'F')
+	{
+		return Hex - 'A' + 10;
+	}
+	if (Hex >= 'a' && Hex <= 'f')
+	{
+		return Hex - 'a' + 10;
+	}
+	return -1;
+}
+
+float TemperatureSensor::shiftTemperatureArray(TemperatureProbe& Probe, const float& newValue)
+{
+	if (Probe.temperature < -40) //Initial
 	{
 		for (int i = 0; i < TEMPERATURE_AVERAGE_ARRAY_SIZE; i++)
 		{
-			temparature_array[i] = newValue;
+			Probe.temperatureArray[i] = newValue;
 		}
 		return newValue;
 	}
 	else
 	{
+		//Averaged over the depth of the profile, the first entries of the array
+		uint8_t averageDepth = GetProfileSettings(profile).averageDepth;
 		float temperatureTotal = 0;
-		memcpy(temparature_array, &temparature_array[1], sizeof(temparature_array) - sizeof(float));
-		temparature_array[TEMPERATURE_AVERAGE_ARRAY_SIZE - 1] = newValue;
+		memmove(Probe.temperatureArray, &Probe.temperatureArray[1], (averageDepth - 1) * sizeof(float));
+		Probe.temperatureArray[averageDepth - 1] = newValue;
 
-		for (int i = 0; i < TEMPERATURE_AVERAGE_ARRAY_SIZE; i++)
+		for (int i = 0; i < averageDepth; i++)
 		{
-			temperatureTotal += temparature_array[i];
+			temperatureTotal += Probe.temperatureArray[i];
 		}
-		return temperatureTotal / TEMPERATURE_AVERAGE_ARRAY_SIZE;
+		return temperatureTotal / averageDepth;
 	}
 }
 
-void TemperatureSensor::SetTemperature(const float& newTemperature)
+void TemperatureSensor::SetTemperature(const uint8_t& Probe, const float& newTemperature)
 {
-	if (newTemperature != this->MessuredTemperature)
+	TemperatureProbe& probe = probes[Probe];
+	if (newTemperature != probe.temperature)
 	{
-		this->MessuredTemperature = newTemperature;
-		if (__CB_TEMPERATURE_CHANGED != NULL)
+		probe.temperature = newTemperature;
+		if (probe.reportPolicy.Update(newTemperature))
 		{
-			__CB_TEMPERATURE_CHANGED(newTemperature);
+			Report(Probe, newTemperature);
 		}
 	}
-}
\ No newline at end of file
+}
+
+void TemperatureSensor::Report(const uint8_t& Probe, const float& Temperature)
+{
+	if (Probe == 0 && __CB_TEMPERATURE_CHANGED != NULL)
+	{
+		__CB_TEMPERATURE_CHANGED(Temperature);
+	}
+	if (__CB_PROBE_TEMPERATURE_CHANGED != NULL)
+	{
+		__CB_PROBE_TEMPERATURE_CHANGED(Probe, Temperature);
+	}
+}
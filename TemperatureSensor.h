@@ -21,29 +21,115 @@
 	#include "WProgram.h"
 #endif
 
-#include <OneWire.h>
-#include <DallasTemperature.h>
+#include "TemperatureBus.h"
+#include "ReportPolicy.h"
 
-#define TEMPERATURE_REFRESH_INTERVAL 50005 // Once every 50 seconds (and 5 ms for time drift)
-#define TEMPERATURE_AVERAGE_ARRAY_SIZE 5
+#define TEMPERATURE_REFRESH_INTERVAL 50005 // Once every 50 seconds (and 5 ms for time drift), 12 bit profile
+#define TEMPERATURE_AVERAGE_ARRAY_SIZE 8 //Largest averaging depth of the profiles
+#define TEMPERATURE_CONVERSION_MARGIN 2 //ms on top of the datasheet conversion time before the scratchpad is read anyway
+#define TEMPERATURE_CONVERSION_POLL_INTERVAL 10 //ms between conversion complete polls of the bus
+#define TEMPERATURE_PROFILE_COUNT 4
+#define TEMPERATURE_PROFILE_FIELD_LEN 3 //Params field: the resolution in bits, 9..12
+#define TEMPERATURE_MAX_PROBES 4 //Probes on the bus, each its own channel
+#define TEMPERATURE_PROBEMAP_FIELD_LEN (TEMPERATURE_MAX_PROBES * 17) //Params field: ROM code per channel in hex, comma separated
+#define TEMPERATURE_RESCAN_INTERVAL 600000 //Bus enumerated again every 10 minutes, for added or removed probes
+#define TEMPERATURE_REPORT_POLICY 0.1f, 0, 0.05f, 0, 1800000 //Station report policy, see ReportPolicy::Configure
+
+namespace TEMPERATURESENSOR_STATEENUM
+{
+	enum TEMPERATURESENSOR_STATE :uint8_t
+	{
+		TEMPERATURESENSOR_STATE_IDLE = 0, //Waiting for the next refresh
+		TEMPERATURESENSOR_STATE_CONVERTING = 1, //Conversion started, scratchpad read when the conversion time has passed
+		TEMPERATURESENSOR_STATE_READING = 2, //Scratchpads read by address, one probe per Process()
+		TEMPERATURESENSOR_STATE_SCANNING = 3, //Bus enumerated, one ROM per Process()
+		TEMPERATURESENSOR_STATE_CONFIGURING = 4, //Resolution of the profile written, one probe per Process()
+	};
+}
+typedef TEMPERATURESENSOR_STATEENUM::TEMPERATURESENSOR_STATE TEMPERATURESENSOR_STATE;
+
+//Resolution profiles, each with the averaging depth and refresh interval that suit its step size and conversion time
+namespace TEMPERATURE_PROFILEENUM
+{
+	enum TEMPERATURE_PROFILE :uint8_t
+	{
+		TEMPERATURE_PROFILE_9BIT = 0, //0.5 degree steps, 94ms conversion, every 10s, 8 readings averaged
+		TEMPERATURE_PROFILE_10BIT = 1, //0.25 degree steps, 188ms conversion, every 20s, 6 readings averaged
+		TEMPERATURE_PROFILE_11BIT = 2, //0.125 degree steps, 375ms conversion, every 30s, 5 readings averaged
+		TEMPERATURE_PROFILE_12BIT = 3, //0.0625 degree steps, 750ms conversion, every 50s, 5 readings averaged
+	};
+}
+typedef TEMPERATURE_PROFILEENUM::TEMPERATURE_PROFILE TEMPERATURE_PROFILE;
+
+struct TemperatureProfileSettings
+{
+	uint8_t resolution;
+	uint8_t averageDepth;
+	unsigned long refreshInterval;
+};
+
+//A probe keeps its channel for as long as the station runs, also while it is disconnected
+struct TemperatureProbe
+{
+	DeviceAddress address;
+	bool inUse;
+	bool present;
+	float temperatureArray[TEMPERATURE_AVERAGE_ARRAY_SIZE];
+	float temperature; //Below -40 until the first reading
+	ReportPolicy reportPolicy;
+};
 
 class TemperatureSensor
 {
 public:
-	TemperatureSensor(const uint8_t &SensorPin);
+	TemperatureSensor(const uint8_t &SensorPin, const TEMPERATUREBUS_TYPE BusType = TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_BITBANG);
 	~TemperatureSensor();
 	void Process();	
-	void SetOnTemperatureChangeEvent(void(*callback)(const float& Temperature)) { __CB_TEMPERATURE_CHANGED = callback; }
+	void PollConversion(); //Cheap outside a conversion, call every loop pass so the conversion time is measured to TEMPERATURE_CONVERSION_POLL_INTERVAL
+	void SetOnTemperatureChangeEvent(void(*callback)(const float& Temperature)) { __CB_TEMPERATURE_CHANGED = callback; } //Channel 0
+	void SetOnProbeTemperatureChangeEvent(void(*callback)(const uint8_t& Probe, const float& Temperature)) { __CB_PROBE_TEMPERATURE_CHANGED = callback; }
 	float GetTemperature();
+	float GetProbeTemperature(const uint8_t& Probe);
+	uint8_t GetProbeCount();
+	bool IsProbePresent(const uint8_t& Probe);
+	String GetProbeAddress(const uint8_t& Probe);
+	bool SetProbeMap(const char* ProbeMap); //Channels from a saved GetProbeMap, the bus is enumerated again by Process()
+	String GetProbeMap(); //To save, clears IsProbeMapChanged
+	bool IsProbeMapChanged() { return isProbeMapChanged; } //A probe got a channel since the last GetProbeMap
+	TEMPERATURESENSOR_STATE GetState() { return state; }
+	TEMPERATUREBUS_TYPE GetBusType() { return temperatureBus->GetType(); }
+	void SetProfile(const TEMPERATURE_PROFILE& Profile);
+	TEMPERATURE_PROFILE GetProfile() { return profile; }
+	static const TemperatureProfileSettings& GetProfileSettings(const TEMPERATURE_PROFILE& Profile);
+	unsigned long GetMeasuredConversionMillis(const TEMPERATURE_PROFILE& Profile); //Last conversion with the profile seen done on the bus, 0 if none
+	String GetProfileString();
+	ReportPolicy& GetReportPolicy(const uint8_t& Probe = 0) { return probes[Probe < TEMPERATURE_MAX_PROBES ? Probe : 0].reportPolicy; }
 private:
-	OneWire* oneWireBus = NULL;
-	DallasTemperature* oTemperatureSensor = NULL;
+	TemperatureBus* temperatureBus = NULL;
 	unsigned long previousWeatherInfoCollectMillis = 0;
+	unsigned long conversionStartMillis = 0;
+	unsigned long conversionMillis = 0;
+	unsigned long previousScanMillis = 0;
+	unsigned long previousConversionPollMillis = 0;
+	unsigned long measuredConversionMillis[TEMPERATURE_PROFILE_COUNT] = { 0 };
+	TEMPERATURE_PROFILE profile = TEMPERATURE_PROFILE::TEMPERATURE_PROFILE_12BIT;
+	bool isResolutionPending = false; //Written to the probes before the next conversion
+	bool isProbeMapChanged = false;
+	uint8_t presentBeforeScan = 0; //Bit per channel
+	TEMPERATURESENSOR_STATE state = TEMPERATURESENSOR_STATE::TEMPERATURESENSOR_STATE_IDLE;
+	uint8_t stateIndex = 0; //Probe or ROM index of the reading or scanning state
+	TemperatureProbe probes[TEMPERATURE_MAX_PROBES];
+	void StartConversion();
+	void ReadProbe(const uint8_t& Probe);
+	void StartScan();
+	bool ScanNext();
+	void AddProbe(const DeviceAddress& Address);
 	void(*__CB_TEMPERATURE_CHANGED)(const float& Temperature) = NULL;
-	float temparature_array[TEMPERATURE_AVERAGE_ARRAY_SIZE] = {0};
-	float MessuredTemperature = -50; //Initial temperature to force update
-	float shiftTemperatureArray(const float& newValue);
-	void SetTemperature(const float& newTemperature);
+	void(*__CB_PROBE_TEMPERATURE_CHANGED)(const uint8_t& Probe, const float& Temperature) = NULL;
+	float shiftTemperatureArray(TemperatureProbe& Probe, const float& newValue);
+	static int8_t hexNibble(const char& Hex);
+	void SetTemperature(const uint8_t& Probe, const float& newTemperature);
+	void Report(const uint8_t& Probe, const float& Temperature);
 };
 
 #endif
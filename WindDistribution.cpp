@@ -0,0 +1,127 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WindDistribution.h"
+
+WindDistribution::WindDistribution(const uint16_t& BucketWidth)
+{
+    bucketWidth = (BucketWidth == 0) ? 1 : BucketWidth;
+    Clear();
+}
+
+void WindDistribution::Clear()
+{
+    for (uint8_t i = 0; i < WINDDISTRIBUTION_BUCKETS; i++)
+    {
+        histogram[i] = 0;
+        bucketSum[i] = 0;
+    }
+    count = 0;
+    sum = 0;
+    sumSquares = 0;
+}
+
+uint8_t WindDistribution::GetBucket(const unsigned int& Value)
+{
+    unsigned int bucket = Value / bucketWidth;
+    return (bucket >= WINDDISTRIBUTION_BUCKETS) ? WINDDISTRIBUTION_BUCKETS - 1 : (uint8_t)bucket;
+}
+
+void WindDistribution::Insert(const unsigned int& Value)
+{
+    uint8_t bucket = GetBucket(Value);
+    histogram[bucket]++;
+    bucketSum[bucket] += Value;
+    count++;
+    sum += Value;
+    sumSquares += (uint64_t)Value * Value;
+}
+
+void WindDistribution::Remove(const unsigned int& Value)
+{
+    uint8_t bucket = GetBucket(Value);
+    if (count == 0 || histogram[bucket] == 0)
+    {
+        return;
+    }
+    histogram[bucket]--;
+    bucketSum[bucket] -= Value;
+    count--;
+    sum -= Value;
+    sumSquares -= (uint64_t)Value * Value;
+}
+
+void WindDistribution::Replace(const unsigned int& Added, const unsigned int& Removed)
+{
+    Remove(Removed);
+    Insert(Added);
+}
+
+float WindDistribution::GetMean()
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    return (float)sum / count;
+}
+
+float WindDistribution::GetStdDev()
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    //Sums are exact integers, so the variance does not drift however long the window slides
+    double mean = (double)sum / count;
+    double variance = (double)sumSquares / count - mean * mean;
+    return (variance > 0) ? (float)sqrt(variance) : 0;
+}
+
+float WindDistribution::GetTurbulenceIntensity()
+{
+    float mean = GetMean();
+    if (mean <= 0)
+    {
+        return 0;
+    }
+    return GetStdDev() / mean;
+}
+
+float WindDistribution::GetPercentile(const uint8_t& Percent)
+{
+    if (count == 0)
+    {
+        return 0;
+    }
+    float rank = ((float)(Percent > 100 ? 100 : Percent) * count) / 100;
+    uint16_t below = 0;
+    for (uint8_t i = 0; i < WINDDISTRIBUTION_BUCKETS; i++)
+    {
+        if (histogram[i] > 0 && below + histogram[i] >= rank)
+        {
+            //Within one bucket width of the exact percentile, exact when the bucket holds a single value
+            return (float)bucketSum[i] / histogram[i];
+        }
+        below += histogram[i];
+    }
+    return 0;
+}
+
+uint16_t WindDistribution::GetBucketCount(const uint8_t& Bucket)
+{
+    if (Bucket >= WINDDISTRIBUTION_BUCKETS)
+    {
+        return 0;
+    }
+    return histogram[Bucket];
+}
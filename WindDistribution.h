@@ -0,0 +1,54 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WindDistribution.h
+
+#ifndef _WINDDISTRIBUTION_h
+#define _WINDDISTRIBUTION_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define WINDDISTRIBUTION_BUCKETS 64 //The last bucket also holds everything above the histogram range
+
+//Distribution of the samples in a sliding window: a fixed bucket histogram plus the sum and sum of squares.
+//The owner reports the sample entering and the sample leaving the window, so an update is O(1).
+//Percentiles are estimated from the histogram when asked for, as the mean of the bucket holding the percentile.
+class WindDistribution
+{
+private:
+	uint16_t bucketWidth = 1;
+	uint16_t histogram[WINDDISTRIBUTION_BUCKETS] = { 0 };
+	uint32_t bucketSum[WINDDISTRIBUTION_BUCKETS] = { 0 };
+	uint16_t count = 0;
+	uint64_t sum = 0;
+	uint64_t sumSquares = 0;
+	uint8_t GetBucket(const unsigned int& Value);
+public:
+	WindDistribution(const uint16_t& BucketWidth);
+	void Clear();
+	void Insert(const unsigned int& Value);
+	void Remove(const unsigned int& Value);
+	void Replace(const unsigned int& Added, const unsigned int& Removed);
+	float GetMean();
+	float GetStdDev();
+	float GetTurbulenceIntensity(); //Standard deviation / mean, 0 without wind
+	float GetPercentile(const uint8_t& Percent);
+	uint16_t GetBucketCount(const uint8_t& Bucket);
+	uint16_t GetBucketWidth() { return bucketWidth; }
+	uint16_t GetCount() { return count; }
+};
+
+#endif
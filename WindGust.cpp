@@ -0,0 +1,104 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WindGust.h"
+
+void WindGust::PruneWindow(const uint32_t& NowMicros)
+{
+    while (windowTail != readIndex && (uint32_t)(NowMicros - pulseTimes[windowTail & WINDGUST_RING_MASK]) >= WINDGUST_WINDOW_US)
+    {
+        windowTail = windowTail + 1;
+    }
+}
+
+void WindGust::AddPulses(const uint32_t& Micros, const uint32_t& Count)
+{
+    //One free space check and one writeIndex update for the whole count
+    uint16_t w = writeIndex;
+    uint16_t space = WINDGUST_RING_SIZE - (uint16_t)(w - windowTail);
+    uint16_t count = Count > space ? space : (uint16_t)Count;
+    overflowCount += Count - count;
+    for (uint16_t i = 0; i < count; i++)
+    {
+        pulseTimes[(w + i) & WINDGUST_RING_MASK] = Micros;
+    }
+    writeIndex = w + count;
+}
+
+void WindGust::Process(const uint32_t& NowMicros)
+{
+    uint16_t w = writeIndex;
+    //The running count only drops between pulses, so the maximum is always found at a pulse
+    while (readIndex != w)
+    {
+        uint32_t pulseMicros = pulseTimes[readIndex & WINDGUST_RING_MASK];
+        readIndex++;
+        PruneWindow(pulseMicros);
+        UpdatePulsePeriod(pulseMicros);
+        uint16_t count = GetWindowCount();
+        if (count > periodMaxCount)
+        {
+            periodMaxCount = count;
+        }
+    }
+    PruneWindow(NowMicros);
+}
+
+void WindGust::UpdatePulsePeriod(const uint32_t& PulseMicros)
+{
+    //Only pulses inside the gust window are read, the interrupt may already reuse older ring positions
+    if ((uint16_t)(periodTail - windowTail) > (uint16_t)(readIndex - windowTail))
+    {
+        periodTail = windowTail;
+    }
+    //Keep at least one interval, drop the pulses more than a second before this one
+    while ((uint16_t)(readIndex - 1 - periodTail) > 1 && (uint32_t)(PulseMicros - pulseTimes[periodTail & WINDGUST_RING_MASK]) > WINDGUST_PERIOD_US)
+    {
+        periodTail = periodTail + 1;
+    }
+    uint16_t intervals = (uint16_t)(readIndex - 1 - periodTail);
+    if (intervals == 0)
+    {
+        pulsePeriodMicros = 0;
+    }
+    else
+    {
+        //Many pulses: the count over the last second, few pulses: the time between the last two
+        pulsePeriodMicros = (uint32_t)(PulseMicros - pulseTimes[periodTail & WINDGUST_RING_MASK]) / intervals;
+    }
+    lastPulseMicros = PulseMicros;
+}
+
+float WindGust::GetPulseFrequency(const uint32_t& NowMicros)
+{
+    if (pulsePeriodMicros == 0)
+    {
+        return 0;
+    }
+    //Without a new pulse the speed can not be higher than one pulse in the time since the last one
+    uint32_t period = pulsePeriodMicros;
+    uint32_t sinceLastPulse = NowMicros - lastPulseMicros;
+    if (sinceLastPulse > period)
+    {
+        period = sinceLastPulse;
+    }
+    if (period >= WINDGUST_WINDOW_US)
+    {
+        return 0;
+    }
+    return 1000000.0f / period;
+}
+
+void WindGust::StartPeriod()
+{
+    periodMaxCount = GetWindowCount();
+}
@@ -0,0 +1,68 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WindGust.h
+
+#ifndef _WINDGUST_h
+#define _WINDGUST_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define WINDGUST_RING_SIZE 512 //Power of 2, holds 3 seconds of pulses up to ~170 pulses per second (~70 m/s)
+#define WINDGUST_RING_MASK (WINDGUST_RING_SIZE - 1)
+#define WINDGUST_WINDOW_US 3000000 //WMO gust: highest 3 second running mean
+#define WINDGUST_PERIOD_US 1000000 //Pulse period is averaged over the intervals of the last second
+
+//Per pulse timestamps from the interrupt, in a single producer / single consumer ring.
+//The interrupt only writes pulseTimes and writeIndex, Process() only writes readIndex and windowTail,
+//so no locking is needed. The pulses between windowTail and readIndex are the current 3 second window.
+class WindGust
+{
+private:
+	volatile uint32_t pulseTimes[WINDGUST_RING_SIZE] = { 0 };
+	volatile uint16_t writeIndex = 0;
+	volatile uint16_t windowTail = 0;
+	uint16_t readIndex = 0;
+	volatile uint32_t overflowCount = 0;
+	uint16_t periodMaxCount = 0;
+	uint16_t periodTail = 0; //Oldest pulse of the pulse period average
+	uint32_t lastPulseMicros = 0;
+	uint32_t pulsePeriodMicros = 0; //0 when there is no previous pulse in the gust window
+	void PruneWindow(const uint32_t& NowMicros);
+	void UpdatePulsePeriod(const uint32_t& PulseMicros);
+public:
+	inline void IRAM_ATTR AddPulse(const uint32_t& Micros)
+	{
+		uint16_t w = writeIndex;
+		if ((uint16_t)(w - windowTail) >= WINDGUST_RING_SIZE)
+		{
+			overflowCount++;
+			return;
+		}
+		pulseTimes[w & WINDGUST_RING_MASK] = Micros;
+		writeIndex = w + 1;
+	}
+	void AddPulses(const uint32_t& Micros, const uint32_t& Count); //Pulses counted elsewhere, all at the same time
+	void Process(const uint32_t& NowMicros);
+	void StartPeriod();
+	uint16_t GetPeriodMaxCount() { return periodMaxCount; }
+	uint16_t GetWindowCount() { return (uint16_t)(readIndex - windowTail); }
+	uint32_t GetOverflowCount() { return overflowCount; }
+	uint32_t GetPulsePeriodMicros() { return pulsePeriodMicros; }
+	float GetPulseFrequency(const uint32_t& NowMicros);
+};
+
+#endif
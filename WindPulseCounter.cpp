@@ -0,0 +1,193 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WindPulseCounter.h"
+
+DRAM_ATTR WindPulseISRContext WindPulseCounterISR::contexts[WINDPULSECOUNTER_ISR_MAX_PINS];
+
+void IRAM_ATTR WindPulseCounterISR::PulseInterrupt(void* Arg)
+{
+    WindPulseISRContext* pinContext = (WindPulseISRContext*)Arg;
+    uint32_t now = WINDPULSECOUNTER_ISR_MICROS();
+    if ((uint32_t)(now - pinContext->lastPulseMicros) < pinContext->debounceMicros)
+    {
+        pinContext->rejectedCount++;
+        return;
+    }
+    pinContext->lastPulseMicros = now;
+    pinContext->pulseCount++;
+    pinContext->gust->AddPulse(now);
+}
+
+WindPulseCounterISR::~WindPulseCounterISR()
+{
+    if (context != NULL)
+    {
+#ifdef ESP32
+        gpio_isr_handler_remove((gpio_num_t)context->pin);
+#else
+        detachInterrupt(digitalPinToInterrupt(context->pin));
+#endif
+        context->inUse = false;
+        context = NULL;
+    }
+}
+
+bool WindPulseCounterISR::Begin(const uint8_t& Pin, WindGust* Gust)
+{
+    WindPulseISRContext* freeContext = NULL;
+    for (uint8_t i = 0; i < WINDPULSECOUNTER_ISR_MAX_PINS; i++)
+    {
+        if (contexts[i].inUse && contexts[i].pin == Pin)
+        {
+            return false;
+        }
+        if (!contexts[i].inUse && freeContext == NULL)
+        {
+            freeContext = &contexts[i];
+        }
+    }
+    if (freeContext == NULL)
+    {
+        return false;
+    }
+    freeContext->pulseCount = 0;
+    freeContext->rejectedCount = 0;
+    freeContext->debounceMicros = debounceMicros;
+    freeContext->lastPulseMicros = WINDPULSECOUNTER_ISR_MICROS() - debounceMicros;
+    freeContext->gust = Gust;
+    freeContext->pin = Pin;
+    freeContext->inUse = true;
+    collectedCount = 0;
+
+    pinMode(Pin, INPUT);
+#ifdef ESP32
+    //Fails with ESP_ERR_INVALID_STATE when the service is already installed, then the handler runs
+    //on that service and is deferred during flash writes, one pending edge is kept by the GPIO
+    esp_err_t err = gpio_install_isr_service(ESP_INTR_FLAG_IRAM);
+    if ((err != ESP_OK && err != ESP_ERR_INVALID_STATE) ||
+        gpio_set_intr_type((gpio_num_t)Pin, GPIO_INTR_NEGEDGE) != ESP_OK ||
+        gpio_isr_handler_add((gpio_num_t)Pin, PulseInterrupt, freeContext) != ESP_OK)
+    {
+        freeContext->inUse = false;
+        return false;
+    }
+    gpio_intr_enable((gpio_num_t)Pin);
+#else
+    attachInterruptArg(digitalPinToInterrupt(Pin), PulseInterrupt, freeContext, FALLING);
+#endif
+    context = freeContext;
+    return true;
+}
+
+unsigned int WindPulseCounterISR::Collect()
+{
+    if (context == NULL)
+    {
+        return 0;
+    }
+    //The interrupt only increments, a single 32 bit read needs no interrupt lock and no pulse is lost or counted twice
+    uint32_t count = context->pulseCount;
+    unsigned int delta = (unsigned int)(count - collectedCount);
+    collectedCount = count;
+    return delta;
+}
+
+bool WindPulseCounterISR::SetDebounceMicros(const uint32_t& Micros)
+{
+    if (Micros > WINDPULSECOUNTER_DEBOUNCE_MAX_US)
+    {
+        return false;
+    }
+    debounceMicros = Micros;
+    if (context != NULL)
+    {
+        context->debounceMicros = Micros;
+    }
+    return true;
+}
+
+uint32_t WindPulseCounterISR::GetRejectedCount()
+{
+    return (context == NULL) ? 0 : context->rejectedCount;
+}
+
+#ifdef ESP32
+WindPulseCounterPCNT::~WindPulseCounterPCNT()
+{
+    if (isStarted)
+    {
+        pcnt_counter_pause(WINDPULSECOUNTER_PCNT_UNIT);
+    }
+}
+
+bool WindPulseCounterPCNT::Begin(const uint8_t& Pin, WindGust* Gust)
+{
+    windGust = Gust;
+    pinMode(Pin, INPUT);
+
+    pcnt_config_t pcntConfig = {};
+    pcntConfig.pulse_gpio_num = Pin;
+    pcntConfig.ctrl_gpio_num = PCNT_PIN_NOT_USED;
+    pcntConfig.channel = PCNT_CHANNEL_0;
+    pcntConfig.unit = WINDPULSECOUNTER_PCNT_UNIT;
+    pcntConfig.pos_mode = PCNT_COUNT_DIS;
+    pcntConfig.neg_mode = PCNT_COUNT_INC; //Falling edge, same as the interrupt
+    pcntConfig.lctrl_mode = PCNT_MODE_KEEP;
+    pcntConfig.hctrl_mode = PCNT_MODE_KEEP;
+    pcntConfig.counter_h_lim = WINDPULSECOUNTER_PCNT_LIMIT;
+    pcntConfig.counter_l_lim = 0;
+
+    if (pcnt_unit_config(&pcntConfig) != ESP_OK)
+    {
+        return false;
+    }
+    pcnt_set_filter_value(WINDPULSECOUNTER_PCNT_UNIT, WINDPULSECOUNTER_PCNT_FILTER);
+    pcnt_filter_enable(WINDPULSECOUNTER_PCNT_UNIT);
+    pcnt_counter_pause(WINDPULSECOUNTER_PCNT_UNIT);
+    pcnt_counter_clear(WINDPULSECOUNTER_PCNT_UNIT);
+    pcnt_counter_resume(WINDPULSECOUNTER_PCNT_UNIT);
+    lastCounterValue = 0;
+    isStarted = true;
+    return true;
+}
+
+void WindPulseCounterPCNT::Poll()
+{
+    int16_t counterValue = 0;
+    if (!isStarted || pcnt_get_counter_value(WINDPULSECOUNTER_PCNT_UNIT, &counterValue) != ESP_OK)
+    {
+        return;
+    }
+    //The counter is never cleared while running, a clear could lose the pulses between read and clear
+    int32_t delta = (int32_t)counterValue - (int32_t)lastCounterValue;
+    if (delta < 0)
+    {
+        delta += WINDPULSECOUNTER_PCNT_LIMIT;
+    }
+    lastCounterValue = counterValue;
+    pendingCount += (unsigned int)delta;
+
+    if (delta > 0)
+    {
+        windGust->AddPulses((uint32_t)micros(), (uint32_t)delta);
+    }
+}
+
+unsigned int WindPulseCounterPCNT::Collect()
+{
+    Poll();
+    unsigned int count = pendingCount;
+    pendingCount = 0;
+    return count;
+}
+#endif
@@ -0,0 +1,121 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WindPulseCounter.h
+
+#ifndef _WINDPULSECOUNTER_h
+#define _WINDPULSECOUNTER_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#include "WindGust.h"
+
+#ifdef ESP32
+	#include "driver/pcnt.h"
+	#include "driver/gpio.h"
+	#include "esp_timer.h"
+	#define WINDPULSECOUNTER_ISR_MICROS() ((uint32_t)esp_timer_get_time()) //IRAM safe, micros() is only in IRAM with CONFIG_ARDUINO_ISR_IRAM
+#else
+	#define WINDPULSECOUNTER_ISR_MICROS() ((uint32_t)micros())
+#endif
+
+#define WINDPULSECOUNTER_PCNT_UNIT PCNT_UNIT_0
+#define WINDPULSECOUNTER_PCNT_LIMIT 32767 //Counter restarts at 0 when reaching the limit
+#define WINDPULSECOUNTER_PCNT_FILTER 1023 //Glitch filter in APB clock cycles, max 1023 (12.8us at 80MHz)
+#define WINDPULSECOUNTER_ISR_MAX_PINS 4 //Pins the interrupt counter can serve at the same time
+#define WINDPULSECOUNTER_DEBOUNCE_US 1000 //Reed switch bounce is shorter, at 70 m/s the pulses are still ~6ms apart
+#define WINDPULSECOUNTER_DEBOUNCE_MAX_US 5000
+
+namespace WINDPULSECOUNTER_TYPEENUM
+{
+	enum WINDPULSECOUNTER_TYPE :uint8_t
+	{
+		WINDPULSECOUNTER_TYPE_ISR = 0,
+		WINDPULSECOUNTER_TYPE_PCNT = 1,
+	};
+}
+typedef WINDPULSECOUNTER_TYPEENUM::WINDPULSECOUNTER_TYPE WINDPULSECOUNTER_TYPE;
+
+//Source of the anemometer pulses. Pulses are reported to the gust meter as they are seen,
+//Collect() returns the number of pulses since the previous Collect().
+class WindPulseCounter
+{
+public:
+	virtual ~WindPulseCounter() {}
+	virtual bool Begin(const uint8_t& Pin, WindGust* Gust) = 0;
+	virtual void Poll() {}
+	virtual unsigned int Collect() = 0;
+	virtual WINDPULSECOUNTER_TYPE GetType() = 0;
+	virtual bool SetDebounceMicros(const uint32_t& Micros) { return false; } //False when the counter can not debounce this long
+	virtual uint32_t GetRejectedCount() { return 0; }
+};
+
+//State of one pin for the interrupt, kept in DRAM so the interrupt does not depend on flash
+struct WindPulseISRContext
+{
+	volatile uint32_t pulseCount; //Accepted pulses since Begin(), only written by the interrupt
+	volatile uint32_t rejectedCount; //Edges within the debounce time of the previous pulse
+	volatile uint32_t lastPulseMicros;
+	volatile uint32_t debounceMicros;
+	WindGust* gust;
+	uint8_t pin;
+	bool inUse;
+};
+
+//A GPIO interrupt on every pulse, gives exact per pulse timestamps.
+//The interrupt is a static IRAM function that gets its pin context as argument, no functor or object call.
+//On the ESP32 it is registered on an IRAM GPIO interrupt service, so pulses keep being counted during
+//flash writes (OTA, EEPROM.end()). Other handlers on that service must then be IRAM safe as well.
+class WindPulseCounterISR : public WindPulseCounter
+{
+private:
+	static WindPulseISRContext contexts[WINDPULSECOUNTER_ISR_MAX_PINS];
+	static void IRAM_ATTR PulseInterrupt(void* Arg);
+	WindPulseISRContext* context = NULL;
+	uint32_t collectedCount = 0;
+	uint32_t debounceMicros = WINDPULSECOUNTER_DEBOUNCE_US;
+public:
+	~WindPulseCounterISR();
+	bool Begin(const uint8_t& Pin, WindGust* Gust);
+	unsigned int Collect();
+	WINDPULSECOUNTER_TYPE GetType() { return WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR; }
+	bool SetDebounceMicros(const uint32_t& Micros);
+	uint32_t GetRejectedCount();
+};
+
+#ifdef ESP32
+//The PCNT peripheral counts the pulses in hardware, no CPU time is spent per pulse.
+//Pulses are handed to the gust meter when polled, so gust timing has the resolution of the Process() calls.
+//The glitch filter only rejects pulses up to 12.8us, the millisecond bounce of a reed switch is counted,
+//use it with a bounce free (hall or optical) anemometer only.
+class WindPulseCounterPCNT : public WindPulseCounter
+{
+private:
+	bool isStarted = false;
+	int16_t lastCounterValue = 0;
+	unsigned int pendingCount = 0;
+	WindGust* windGust = NULL;
+public:
+	~WindPulseCounterPCNT();
+	bool Begin(const uint8_t& Pin, WindGust* Gust);
+	void Poll();
+	unsigned int Collect();
+	WINDPULSECOUNTER_TYPE GetType() { return WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT; }
+	bool SetDebounceMicros(const uint32_t& Micros) { return Micros == 0; } //Only the glitch filter
+};
+#endif
+
+#endif
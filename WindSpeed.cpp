@@ -11,38 +11,204 @@
 *
 **************************************************************************************************************/
 #include "WindSpeed.h"
-#include <FunctionalInterrupt.h>
+#include "ConversionTables.h"
 
 float WindSpeed::GetWindGusts()
 {
     return MaxWindGustMS;
 }
 
+float WindSpeed::GetWindMean()
+{
+    return MeanWindMS;
+}
+
+float WindSpeed::GetInstantWindMS()
+{
+    uint16_t windowCount = windGust.GetWindowCount();
+    float countMS = GustCountToMs(windowCount);
+    //The interrupt timestamps every pulse, the PCNT pulses only get the time they were polled
+    if (pulseCounter->GetType() != WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR || windGust.GetPulsePeriodMicros() == 0)
+    {
+        //No pulse period known, the count of the 3 second gust window
+        return countMS;
+    }
+    float periodMS = WindSpeedToMsFromRPM(windGust.GetPulseFrequency((uint32_t)micros()) * WIND_REFRESH_INTERVAL / 1000);
+    //Few pulses: one pulse more or less is a big step of the count, the period resolves the speed.
+    //Many pulses: the count is as fine and steadier than the last second of periods.
+    float countWeight = (float)windowCount / (float)(windowCount + WINDSPEED_INSTANT_BLEND_PULSES);
+    return periodMS + (countMS - periodMS) * countWeight;
+}
+
 uint8_t WindSpeed::GetSpeedBeaufort()
 {
     return SpeedBeaufort;
 }
 
-WindSpeed::WindSpeed(const uint8_t InterruptPin)
+WindSpeed::WindSpeed(const uint8_t InterruptPin, const WINDPULSECOUNTER_TYPE CounterType)
 {
-    pinMode(InterruptPin, INPUT);
-	usedInterruptPin = InterruptPin;	
+    pulsePin = InterruptPin;
     previousWeatherInfoCollectMillis = millis();
-    attachInterrupt(digitalPinToInterrupt(InterruptPin), std::bind(&WindSpeed::WindFaneInterrupt, this), FALLING);
-    for (int i = 0; i < WINDSPEED_ARRAY_SIZE; i++)
+    windStatistics = new WindStatistics(SecondsToSamples(WINDSPEED_HISTORY_SECONDS));
+    windStatistics->AddWindow(String(F("mean10m")), SecondsToSamples(WINDSPEED_BEAUFORT_SECONDS));
+    windStatistics->AddWindow(String(F("mean1m")), SecondsToSamples(WINDSPEED_MEAN_SECONDS));
+    windStatistics->AddWindow(String(F("mean1h")), SecondsToSamples(WINDSPEED_HISTORY_SECONDS));
+    RebuildDistribution();
+
+#ifdef ESP32
+    if (CounterType == WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT)
     {
-        windspeed_array[i] = 0;
+        pulseCounter = new WindPulseCounterPCNT();
+        if (!pulseCounter->Begin(InterruptPin, &windGust))
+        {
+            //Fall back to the interrupt when the pulse counter unit is not available
+            delete pulseCounter;
+            pulseCounter = NULL;
+        }
+    }
+#endif
+    if (pulseCounter == NULL)
+    {
+        pulseCounter = new WindPulseCounterISR();
+        pulseCounter->Begin(InterruptPin, &windGust);
     }
 }
 
 WindSpeed::~WindSpeed()
 {
-	detachInterrupt(usedInterruptPin);
+    if (pulseCounter != NULL)
+    {
+        delete pulseCounter;
+        pulseCounter = NULL;
+    }
+    if (windStatistics != NULL)
+    {
+        delete windStatistics;
+        windStatistics = NULL;
+    }
+}
+
+uint16_t WindSpeed::SecondsToSamples(const uint16_t& Seconds)
+{
+    unsigned long count = ((unsigned long)Seconds * 1000 + sampleInterval - 1) / sampleInterval;
+    return (count == 0) ? 1 : (uint16_t)count;
+}
+
+bool WindSpeed::SetSampleInterval(const unsigned long& IntervalMs)
+{
+    if (IntervalMs < 1000 || IntervalMs > WIND_REFRESH_INTERVAL * 6)
+    {
+        return false;
+    }
+    //Window lengths are kept in seconds, the history restarts with the new bucket size
+    uint16_t windowSeconds[WINDSTATISTICS_MAX_WINDOWS];
+    for (uint8_t i = 0; i < windStatistics->GetWindowCount(); i++)
+    {
+        windowSeconds[i] = (uint16_t)((windStatistics->GetWindowLength(i) * sampleInterval) / 1000);
+    }
+    sampleInterval = IntervalMs;
+    windStatistics->Resize(SecondsToSamples(WINDSPEED_HISTORY_SECONDS));
+    for (uint8_t i = 0; i < windStatistics->GetWindowCount(); i++)
+    {
+        windStatistics->SetWindowLength(i, SecondsToSamples(windowSeconds[i]));
+    }
+    RebuildDistribution();
+    return true;
+}
+
+bool WindSpeed::SetWindowSeconds(const uint8_t& Window, const uint16_t& Seconds)
+{
+    if (Seconds > WINDSPEED_HISTORY_SECONDS)
+    {
+        return false;
+    }
+    if (!windStatistics->SetWindowLength(Window, SecondsToSamples(Seconds)))
+    {
+        return false;
+    }
+    if (Window == WINDSPEED_WINDOW::WINDSPEED_WINDOW_BEAUFORT)
+    {
+        RebuildDistribution();
+    }
+    return true;
+}
+
+void WindSpeed::RebuildDistribution()
+{
+    //Only on reconfiguration, every new sample updates the distribution in place
+    windDistribution.Clear();
+    uint16_t beaufortSamples = windStatistics->GetWindowLength(WINDSPEED_WINDOW::WINDSPEED_WINDOW_BEAUFORT);
+    for (uint16_t age = 0; age < beaufortSamples; age++)
+    {
+        windDistribution.Insert(windStatistics->GetSample(age));
+    }
+}
+
+int8_t WindSpeed::AddWindow(const String& Name, const uint16_t& Seconds)
+{
+    if (Seconds > WINDSPEED_HISTORY_SECONDS)
+    {
+        return -1;
+    }
+    return windStatistics->AddWindow(Name, SecondsToSamples(Seconds));
+}
+
+float WindSpeed::GetWindowAverageMS(const uint8_t& Window)
+{
+    return WindSpeedToMsFromRPM(windStatistics->GetAverage(Window));
+}
+
+float WindSpeed::GetWindPercentileMS(const uint8_t& Percent)
+{
+    return WindSpeedToMsFromRPM(windDistribution.GetPercentile(Percent));
+}
+
+float WindSpeed::GetWindStdDevMS()
+{
+    return WindSpeedToMsFromRPM(windDistribution.GetStdDev());
+}
+
+float WindSpeed::GetTurbulenceIntensity()
+{
+    return windDistribution.GetTurbulenceIntensity();
+}
+
+WINDPULSECOUNTER_TYPE WindSpeed::GetPulseCounterType()
+{
+    return pulseCounter->GetType();
+}
+
+bool WindSpeed::SetDebounceMicros(const uint32_t& Micros)
+{
+    if (pulseCounter->SetDebounceMicros(Micros))
+    {
+        return true;
+    }
+    if (pulseCounter->GetType() == WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR)
+    {
+        return false;
+    }
+    //The PCNT glitch filter is too short for reed switch bounce, a debounce needs the interrupt counter
+    WindPulseCounter* isrCounter = new WindPulseCounterISR();
+    if (!isrCounter->SetDebounceMicros(Micros))
+    {
+        delete isrCounter;
+        return false;
+    }
+    delete pulseCounter;
+    pulseCounter = isrCounter;
+    return pulseCounter->Begin(pulsePin, &windGust);
+}
+
+uint32_t WindSpeed::GetRejectedPulseCount()
+{
+    return pulseCounter->GetRejectedCount();
 }
 
-void WindSpeed::WindFaneInterrupt()
+float WindSpeed::GustCountToMs(const uint16_t& PulsesInWindow)
 {
-	WindFaneCount++;
+    //Pulses in the 3 second gust window, scaled to pulses per WIND_REFRESH_INTERVAL
+    return WindSpeedToMsFromRPM(((float)PulsesInWindow * WIND_REFRESH_INTERVAL) / (WINDGUST_WINDOW_US / 1000));
 }
 
 float WindSpeed::WindSpeedToMsFromRPM(const float &RPMwindspeed)
@@ -53,21 +219,14 @@ float WindSpeed::WindSpeedToMsFromRPM(const float &RPMwindspeed)
 
 uint8_t WindSpeed::Beaufort(const float &Speed)
 {
-    //Serial.print("Input:");
-    //Serial.println(Speed);
-    uint8_t b = pow(pow((Speed / 0.836), 0.33), 2);
-    //Serial.print("Output:");
-    //Serial.println(b);
-    return b;
+    //Threshold table, same result as pow(pow((Speed / 0.836), 0.33), 2)
+    return ConversionTables::Beaufort(Speed);
 }
 
 void WindSpeed::shiftWindspeedArray(const unsigned int &newValue)
 {
     //Serial.print(newValue); Serial.print("-->");
 
-    unsigned long totalspeed = 0;
-    unsigned long LastWindSpeedAverage = 0;
-    
     unsigned int lLastRecorderWindSpeedRPM = newValue / 2;
     if (newValue > 0)
     {
@@ -87,36 +246,14 @@ void WindSpeed::shiftWindspeedArray(const unsigned int &newValue)
         lLastRecorderWindSpeedRPM = LastRecorderWindSpeedRPM;
     }
 
-    /*for (int i = 0; i < WINDSPEED_ARRAY_SIZE; i++)
-    {
-        Serial.print(windspeed_array[i], HEX);
-        Serial.print(',');
-    }
-    Serial.println();*/
-
-    memcpy(windspeed_array, &windspeed_array[1], (WINDSPEED_ARRAY_SIZE - 1) * sizeof(unsigned int));
-    windspeed_array[WINDSPEED_ARRAY_SIZE - 1] = lLastRecorderWindSpeedRPM;    
-
-    for (int i = 0; i < WINDSPEED_ARRAY_SIZE; i++)
-    {
-        totalspeed += (unsigned long)windspeed_array[i];
-        //Serial.print(windspeed_array[i], HEX);
-        //Serial.print(',');
-    }
-
-    for (int i = WINDSPEED_ARRAY_SIZE - WINDSPEED_MAX_SAMPLE_COUNT; i < WINDSPEED_ARRAY_SIZE; i++)
-    {
-        LastWindSpeedAverage += (unsigned long)windspeed_array[i];
-        //Serial.print(windspeed_array[i], HEX);
-        //Serial.print(',');
-    }
+    //The oldest sample of the Beaufort window drops out when the new one is added
+    windDistribution.Replace(lLastRecorderWindSpeedRPM, windStatistics->GetSample(windStatistics->GetWindowLength(WINDSPEED_WINDOW::WINDSPEED_WINDOW_BEAUFORT) - 1));
+    windStatistics->AddSample(lLastRecorderWindSpeedRPM);
 
-    //Serial.println();
+    MaxWindSpeedAvgRPM = windStatistics->GetAverage(WINDSPEED_WINDOW::WINDSPEED_WINDOW_MEAN);
+    AverageWindspeedRPM = windStatistics->GetAverage(WINDSPEED_WINDOW::WINDSPEED_WINDOW_BEAUFORT);
 
-    MaxWindSpeedAvgRPM = (LastWindSpeedAverage / WINDSPEED_MAX_SAMPLE_COUNT);
-    AverageWindspeedRPM = (unsigned int)(totalspeed / (unsigned long)WINDSPEED_ARRAY_SIZE);
-
-    //Serial.print("Avg:");Serial.print(AverageWindspeedRPM); Serial.print(", Tot:"); Serial.print(totalspeed);    
+    //Serial.print("Avg:");Serial.print(AverageWindspeedRPM);
     //Serial.print("**** Average:"); Serial.print(WindSpeedToMsFromRPM(AverageWindspeedRPM)); Serial.print(", BFT:"); Serial.println(Beaufort(WindSpeedToMsFromRPM(AverageWindspeedRPM)));
 
     if (LastTimeSet == 0)
@@ -131,67 +268,220 @@ void WindSpeed::shiftWindspeedArray(const unsigned int &newValue)
 
 String WindSpeed::GetValues()
 {
-    String Values = "";
-    for (int i = 0; i < WINDSPEED_ARRAY_SIZE; i++)
+    //Every line is formatted on the stack, the result is allocated once
+    char line[WINDSPEED_VALUES_LINE_LEN];
+    uint16_t beaufortSamples = windStatistics->GetWindowLength(WINDSPEED_WINDOW::WINDSPEED_WINDOW_BEAUFORT);
+    String Values;
+    Values.reserve(beaufortSamples * 16 + (windStatistics->GetWindowCount() + WINDDISTRIBUTION_BUCKETS + 20) * 32);
+    for (uint16_t i = 0; i < beaufortSamples; i++)
     {
-        Values += "V:" + String(i) + "->" + String(windspeed_array[i]) + "\r\n";
+        snprintf(line, sizeof(line), "V:%u->%u\r\n", i, windStatistics->GetSample(beaufortSamples - 1 - i));
+        Values += line;
+    }
+    for (uint8_t i = 0; i < windStatistics->GetWindowCount(); i++)
+    {
+        snprintf(line, sizeof(line), "W:%s(%lus)->%.2f\r\n", windStatistics->GetWindowName(i).c_str(),
+            (unsigned long)windStatistics->GetWindowLength(i) * sampleInterval / 1000, GetWindowAverageMS(i));
+        Values += line;
     }
     float flMaxWindGustMS = WindSpeedToMsFromRPM(MaxWindSpeedAvgRPM);
     unsigned int ulSpeedBeaufort = Beaufort(WindSpeedToMsFromRPM(AverageWindspeedRPM));
+    const char* cadenceNames[] = { "Fixed", "Calm", "Normal", "Gusty" };
 
-    Values += "MaxRPM:" + String(MaxWindSpeedAvgRPM) + "\r\n";
-    Values += "avgRPM:" + String(AverageWindspeedRPM) + "\r\n";
+    snprintf(line, sizeof(line), "MaxRPM:%u\r\navgRPM:%u\r\n", MaxWindSpeedAvgRPM, AverageWindspeedRPM);
+    Values += line;
+    snprintf(line, sizeof(line), "MaxWindGustMS:%.2f\r\nGust3sMS:%.2f\r\n", flMaxWindGustMS, GustCountToMs(windGust.GetPeriodMaxCount()));
+    Values += line;
+    snprintf(line, sizeof(line), "InstantMS:%.2f\r\nPulsePeriodUs:%lu\r\n", GetInstantWindMS(), (unsigned long)windGust.GetPulsePeriodMicros());
+    Values += line;
+    snprintf(line, sizeof(line), "GustOverflow:%lu\r\nRejectedPulses:%lu\r\n", (unsigned long)windGust.GetOverflowCount(), (unsigned long)pulseCounter->GetRejectedCount());
+    Values += line;
+    snprintf(line, sizeof(line), "Counter:%s\r\nSpeedBeaufort:%u\r\nCadence:%s\r\n", pulseCounter->GetType() == WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT ? "PCNT" : "ISR",
+        ulSpeedBeaufort, cadenceNames[cadence]);
+    Values += line;
 
-    Values += "MaxWindGustMS:" + String(flMaxWindGustMS) + "\r\n";
-    Values += "SpeedBeaufort:" + String(ulSpeedBeaufort) + "\r\n";
+    for (uint8_t i = 0; i < WINDDISTRIBUTION_BUCKETS; i++)
+    {
+        if (windDistribution.GetBucketCount(i) > 0)
+        {
+            if (i == WINDDISTRIBUTION_BUCKETS - 1)
+            {
+                snprintf(line, sizeof(line), "H:%.2f+->%u\r\n", WindSpeedToMsFromRPM((float)i * WINDSPEED_HISTOGRAM_BUCKET), windDistribution.GetBucketCount(i));
+            }
+            else
+            {
+                snprintf(line, sizeof(line), "H:%.2f-%.2f->%u\r\n", WindSpeedToMsFromRPM((float)i * WINDSPEED_HISTOGRAM_BUCKET),
+                    WindSpeedToMsFromRPM((float)(i + 1) * WINDSPEED_HISTOGRAM_BUCKET), windDistribution.GetBucketCount(i));
+            }
+            Values += line;
+        }
+    }
+    snprintf(line, sizeof(line), "P50MS:%.2f\r\nP90MS:%.2f\r\nP99MS:%.2f\r\n", GetWindPercentileMS(50), GetWindPercentileMS(90), GetWindPercentileMS(99));
+    Values += line;
+    snprintf(line, sizeof(line), "StdDevMS:%.2f\r\nTurbulenceIntensity:%.2f\r\n", GetWindStdDevMS(), GetTurbulenceIntensity());
+    Values += line;
 
     return Values;
 }
 
-void WindSpeed::SetWindspeeds(const float& maxWindGustMS, const uint8_t& windSpeedBeaufort)
+void WindSpeed::SetWindspeeds(const float& maxWindGustMS, const float& meanWindMS, const uint8_t& windSpeedBeaufort)
 {
     if (maxWindGustMS != this->MaxWindGustMS)
     {     
         this->MaxWindGustMS = maxWindGustMS;
-        if (__CB_WINDGUST_CHANGED != NULL)
+        if (gustReportPolicy.Update(maxWindGustMS) && __CB_WINDGUST_CHANGED != NULL)
         {
             __CB_WINDGUST_CHANGED(maxWindGustMS);
         }
     }
+    if (meanWindMS != this->MeanWindMS)
+    {
+        this->MeanWindMS = meanWindMS;
+        if (meanReportPolicy.Update(meanWindMS) && __CB_WINDMEAN_CHANGED != NULL)
+        {
+            __CB_WINDMEAN_CHANGED(meanWindMS);
+        }
+    }
     if (windSpeedBeaufort != this->SpeedBeaufort)
     {
         this->SpeedBeaufort = windSpeedBeaufort;
-        if (__CB_WINDBEAUFORT_CHANGED != NULL)
+        if (beaufortReportPolicy.Update(windSpeedBeaufort) && __CB_WINDBEAUFORT_CHANGED != NULL)
         {
             __CB_WINDBEAUFORT_CHANGED(SpeedBeaufort);
         }
     }
 }
 
+void WindSpeed::PollReportPolicies()
+{
+    //Changes held back by a minimum interval, and the periodic reports of unchanged values
+    float value;
+    if (gustReportPolicy.Poll(value) && __CB_WINDGUST_CHANGED != NULL)
+    {
+        __CB_WINDGUST_CHANGED(value);
+    }
+    if (meanReportPolicy.Poll(value) && __CB_WINDMEAN_CHANGED != NULL)
+    {
+        __CB_WINDMEAN_CHANGED(value);
+    }
+    if (beaufortReportPolicy.Poll(value) && __CB_WINDBEAUFORT_CHANGED != NULL)
+    {
+        uint8_t beaufort = (uint8_t)value;
+        __CB_WINDBEAUFORT_CHANGED(beaufort);
+    }
+}
+
+void WindSpeed::SetAdaptiveCadence(const bool& Enabled)
+{
+    if (Enabled == (cadence != WINDSPEED_CADENCE::WINDSPEED_CADENCE_FIXED))
+    {
+        return;
+    }
+    cadence = Enabled ? WINDSPEED_CADENCE::WINDSPEED_CADENCE_NORMAL : WINDSPEED_CADENCE::WINDSPEED_CADENCE_FIXED;
+    if (NoNotifyCounter > GetSkipNotifications())
+    {
+        NoNotifyCounter = GetSkipNotifications();
+    }
+}
+
+uint8_t WindSpeed::GetSkipNotifications()
+{
+    switch (cadence)
+    {
+    case WINDSPEED_CADENCE::WINDSPEED_CADENCE_CALM:
+        return WINDSPEED_CALM_SKIP_NOTIFICATIONS;
+    case WINDSPEED_CADENCE::WINDSPEED_CADENCE_GUSTY:
+        return WINDSPEED_GUSTY_SKIP_NOTIFICATIONS;
+    default:
+        return WINDSPEED_SKIP_NOTIFICATIONS;
+    }
+}
+
+void WindSpeed::UpdateCadence()
+{
+    //Only how often is polled and reported changes, the samples and the 10 minute Beaufort window stay the same.
+    //The sample interval is not shortened when it gets gusty: every sample is the mean over a fixed time, so the
+    //windows would have to be resized and their history would mix sample lengths. The gust meter already follows
+    //every pulse in its 3 second window, gusty reports every sample and a gust onset is reported at once.
+    float meanMS = WindSpeedToMsFromRPM(AverageWindspeedRPM);
+    float mean1mMS = WindSpeedToMsFromRPM(MaxWindSpeedAvgRPM);
+    float gustMS = GustCountToMs(windGust.GetPeriodMaxCount());
+
+    if (meanMS < WINDSPEED_CALM_MS && gustMS < WINDSPEED_CALM_MS)
+    {
+        cadence = WINDSPEED_CADENCE::WINDSPEED_CADENCE_CALM;
+    }
+    else if ((mean1mMS > 0 && gustMS >= mean1mMS * WINDSPEED_GUSTY_RATIO) || windDistribution.GetTurbulenceIntensity() >= WINDSPEED_GUSTY_TURBULENCE)
+    {
+        cadence = WINDSPEED_CADENCE::WINDSPEED_CADENCE_GUSTY;
+    }
+    else
+    {
+        cadence = WINDSPEED_CADENCE::WINDSPEED_CADENCE_NORMAL;
+    }
+    if (NoNotifyCounter > GetSkipNotifications())
+    {
+        NoNotifyCounter = GetSkipNotifications();
+    }
+}
+
+void WindSpeed::ReportWindspeeds()
+{
+    //Gust is the highest 3 second running mean since the last report, never below the 1 minute mean
+    float flMaxWindGustMS = GustCountToMs(windGust.GetPeriodMaxCount());
+    float flMeanWindMS = WindSpeedToMsFromRPM(MaxWindSpeedAvgRPM);
+    if (flMaxWindGustMS < flMeanWindMS)
+    {
+        flMaxWindGustMS = flMeanWindMS;
+    }
+    windGust.StartPeriod();
+    unsigned int ulSpeedBeaufort = Beaufort(WindSpeedToMsFromRPM(AverageWindspeedRPM));
+    SetWindspeeds(flMaxWindGustMS, WindSpeedToMsFromRPM(AverageWindspeedRPM), ulSpeedBeaufort);
+    NoNotifyCounter = GetSkipNotifications();
+}
+
 void WindSpeed::Process()
 {
-    if (millis() - previousWeatherInfoCollectMillis >= (WIND_REFRESH_INTERVAL))
+    bool sampleDue = (millis() - previousWeatherInfoCollectMillis >= sampleInterval);
+    if (!sampleDue && cadence == WINDSPEED_CADENCE::WINDSPEED_CADENCE_CALM && millis() - previousPollMillis < WINDSPEED_CALM_POLL_INTERVAL)
+    {
+        return;
+    }
+    previousPollMillis = millis();
+
+    //Drain the pulse timestamps on every call, the ring only has to hold the 3 second gust window
+    pulseCounter->Poll();
+    windGust.Process((uint32_t)micros());
+
+    if (sampleDue)
     {        
-        noInterrupts();
-        currentWindFaneReading = WindFaneCount;
-        WindFaneCount = 0;
-        interrupts();
+        currentWindFaneReading = pulseCounter->Collect();
         previousWeatherInfoCollectMillis = millis();
         #ifdef BUILD_FOR_TEST_ESP32
             currentWindFaneReading = int((float(rand()) / float((RAND_MAX)) * 100.0));
         #endif // BUILD_FOR_TEST_ESP32
-        shiftWindspeedArray(currentWindFaneReading);
+        //Buckets are kept as pulses per WIND_REFRESH_INTERVAL, which RPM_FACTOR is based on
+        shiftWindspeedArray((unsigned int)(((unsigned long)currentWindFaneReading * WIND_REFRESH_INTERVAL) / sampleInterval));
+
+        if (cadence != WINDSPEED_CADENCE::WINDSPEED_CADENCE_FIXED)
+        {
+            UpdateCadence();
+        }
 
         if (NoNotifyCounter == 0)
         {
-            float flMaxWindGustMS = WindSpeedToMsFromRPM(MaxWindSpeedAvgRPM);
-            unsigned int ulSpeedBeaufort = Beaufort(WindSpeedToMsFromRPM(AverageWindspeedRPM));
-            SetWindspeeds(flMaxWindGustMS, ulSpeedBeaufort);
-            NoNotifyCounter = WINDSPEED_SKIP_NOTIFICATIONS;
+            ReportWindspeeds();
         }
         else
         {
             NoNotifyCounter--;
         }
     }
+    else if (cadence != WINDSPEED_CADENCE::WINDSPEED_CADENCE_FIXED && MaxWindGustMS >= 0 && GustCountToMs(windGust.GetWindowCount()) >= MaxWindGustMS + WINDSPEED_GUST_ONSET_MS)
+    {
+        //Gust onset, report now instead of at the next sample
+        cadence = WINDSPEED_CADENCE::WINDSPEED_CADENCE_GUSTY;
+        ReportWindspeeds();
+    }
+    PollReportPolicies();
 }
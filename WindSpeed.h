@@ -23,47 +23,125 @@
 	#include "WProgram.h"
 #endif
 
-#define WIND_REFRESH_INTERVAL 10000 // Once every 10 seconds
-#define WINDSPEED_ARRAY_SIZE 60 //Baufort is calculated over 10 minutes, with a refresh every 10 seconds, the array needs to store 60 items
+#include "WindStatistics.h"
+#include "WindDistribution.h"
+#include "WindGust.h"
+#include "WindPulseCounter.h"
+#include "ReportPolicy.h"
+
+#define WIND_REFRESH_INTERVAL 10000 // Once every 10 seconds (default sample interval)
+#define WINDSPEED_HISTORY_SECONDS 3600 //Longest window that can be configured, 1 hour
+#define WINDSPEED_BEAUFORT_SECONDS 600 //Baufort is calculated over 10 minutes
+#define WINDSPEED_MEAN_SECONDS 60 // Last 60 seconds mean, lower bound for the reported gust
 #define WINDSPEED_REMBER_TIME 2 //20 seconds
-#define WINDSPEED_MAX_SAMPLE_COUNT 6 // Use last 60 seconds for Wind Speed calculation
 #define WINDSPEED_SKIP_NOTIFICATIONS 2 //Only report every 30 seconds (0-2 * WIND_REFRESH_INTERVAL)
+#define WINDSPEED_CALM_SKIP_NOTIFICATIONS 5 //Adaptive cadence, calm: report every 60 seconds
+#define WINDSPEED_GUSTY_SKIP_NOTIFICATIONS 0 //Adaptive cadence, gusty: report every sample
+#define WINDSPEED_CALM_POLL_INTERVAL 1000 //Adaptive cadence, calm: pulses and gust meter polled once a second
+#define WINDSPEED_CALM_MS 1.5f //Calm when the 10 minute mean and the 3 second gust stay below this
+#define WINDSPEED_GUSTY_RATIO 1.5f //Gusty when the 3 second gust exceeds the 1 minute mean by this factor
+#define WINDSPEED_GUSTY_TURBULENCE 0.3f //or when the turbulence intensity of the 10 minute window exceeds this
+#define WINDSPEED_GUST_ONSET_MS 2.0f //A gust this much above the last reported gust is reported at once
+//Station report policies: absolute deadband, relative deadband, hysteresis, min interval ms, max interval ms
+#define WINDSPEED_GUST_REPORT_POLICY 0.5f, 0.1f, 0.2f, 0, 1800000
+#define WINDSPEED_MEAN_REPORT_POLICY 0.3f, 0.05f, 0.1f, 0, 1800000
+#define WINDSPEED_BEAUFORT_REPORT_POLICY 0, 0, 1, 60000, 1800000
 
 //float pi = 3.14159265;
 //float radius = 0.8;
 //Dual count
 //float RPM_FACTOR = ((2 * pi * radius) / 60) * RPMwindspeed;  // Calculate wind speed on m/s
 #define RPM_FACTOR 0.041887902
+#define WINDSPEED_INSTANT_BLEND_PULSES 24 //Instant speed: the 3 second count weighs as much as the pulse period at this many pulses in the window
+#define WINDSPEED_VALUES_LINE_LEN 96 //GetValues() formats its lines in a buffer of this size, on the stack
+#define WINDSPEED_HISTOGRAM_BUCKET 12 //Pulses per histogram bucket, 12 * RPM_FACTOR is about 0.5 m/s
+
+namespace WINDSPEED_WINDOWENUM
+{
+	enum WINDSPEED_WINDOW :uint8_t
+	{
+		WINDSPEED_WINDOW_BEAUFORT = 0, //10 minute mean
+		WINDSPEED_WINDOW_MEAN = 1, //1 minute mean
+		WINDSPEED_WINDOW_HOUR = 2, //1 hour mean
+	};
+}
+typedef WINDSPEED_WINDOWENUM::WINDSPEED_WINDOW WINDSPEED_WINDOW;
+
+namespace WINDSPEED_CADENCEENUM
+{
+	enum WINDSPEED_CADENCE :uint8_t
+	{
+		WINDSPEED_CADENCE_FIXED = 0, //Adaptive cadence off
+		WINDSPEED_CADENCE_CALM = 1,
+		WINDSPEED_CADENCE_NORMAL = 2,
+		WINDSPEED_CADENCE_GUSTY = 3,
+	};
+}
+typedef WINDSPEED_CADENCEENUM::WINDSPEED_CADENCE WINDSPEED_CADENCE;
 
 class WindSpeed
 {
 private:
-	void WindFaneInterrupt();
-	uint8_t usedInterruptPin = 0;
-	volatile unsigned int WindFaneCount = 0;
-	unsigned int windspeed_array[WINDSPEED_ARRAY_SIZE] = {0};
+	WindPulseCounter* pulseCounter = NULL;
+	uint8_t pulsePin;
+	WindGust windGust;
+	WindStatistics* windStatistics = NULL;
+	WindDistribution windDistribution = WindDistribution(WINDSPEED_HISTOGRAM_BUCKET); //Over the Beaufort window
+	unsigned long sampleInterval = WIND_REFRESH_INTERVAL;
 	unsigned int AverageWindspeedRPM = 0;
 	unsigned int LastRecorderWindSpeedRPM = 0;
 	unsigned int MaxWindSpeedAvgRPM = 0;
 	float MaxWindGustMS = -1;
+	float MeanWindMS = -1;
 	uint8_t SpeedBeaufort = 255;
 	uint8_t LastTimeSet = 0;
 	uint8_t NoNotifyCounter = 1;
+	WINDSPEED_CADENCE cadence = WINDSPEED_CADENCE::WINDSPEED_CADENCE_FIXED;
+	ReportPolicy gustReportPolicy;
+	ReportPolicy meanReportPolicy;
+	ReportPolicy beaufortReportPolicy;
 	unsigned long previousWeatherInfoCollectMillis = 0;
+	unsigned long previousPollMillis = 0;
 	uint8_t Beaufort(const float& Speed);
 	void shiftWindspeedArray(const unsigned int& newValue);
-	void SetWindspeeds(const float& maxWindGustMS, const uint8_t& SpeedBeaufort);
+	void RebuildDistribution();
+	uint16_t SecondsToSamples(const uint16_t& Seconds);
+	void SetWindspeeds(const float& maxWindGustMS, const float& meanWindMS, const uint8_t& SpeedBeaufort);
+	void ReportWindspeeds();
+	void PollReportPolicies();
+	void UpdateCadence();
+	uint8_t GetSkipNotifications();
+	float GustCountToMs(const uint16_t& PulsesInWindow);
 	float WindSpeedToMsFromRPM(const float& RPMwindspeed);
 	void(*__CB_WINDGUST_CHANGED)(const float& maxWindGust) = NULL;
 	void(*__CB_WINDBEAUFORT_CHANGED)(const uint8_t& BeaufortSpeed) = NULL;
+	void(*__CB_WINDMEAN_CHANGED)(const float& meanWind) = NULL;
 public:
 	String GetValues();
 	void SetOnWindGustsChangeEvent(void(*callback)(const float& maxWindGust)) { __CB_WINDGUST_CHANGED = callback; }
 	void SetOnWindBeaufortChangeEvent(void(*callback)(const uint8_t& BeaufortSpeed)) { __CB_WINDBEAUFORT_CHANGED = callback; }
+	void SetOnWindMeanChangeEvent(void(*callback)(const float& meanWind)) { __CB_WINDMEAN_CHANGED = callback; }
 	unsigned int currentWindFaneReading = 0;
 	float GetWindGusts();
+	float GetWindMean();
+	float GetInstantWindMS();
+	bool SetSampleInterval(const unsigned long& IntervalMs);
+	bool SetWindowSeconds(const uint8_t& Window, const uint16_t& Seconds);
+	int8_t AddWindow(const String& Name, const uint16_t& Seconds);
+	float GetWindowAverageMS(const uint8_t& Window);
+	float GetWindPercentileMS(const uint8_t& Percent);
+	float GetWindStdDevMS();
+	float GetTurbulenceIntensity();
 	uint8_t GetSpeedBeaufort();
-	WindSpeed(const uint8_t InterruptPin);	
+	WINDPULSECOUNTER_TYPE GetPulseCounterType();
+	bool SetDebounceMicros(const uint32_t& Micros); //Switches to the interrupt counter when the counter can not debounce, call before Process()
+	void SetAdaptiveCadence(const bool& Enabled); //Reporting and calm polling follow the wind, the sample interval stays fixed
+	WINDSPEED_CADENCE GetCadence() { return cadence; }
+	uint32_t GetRejectedPulseCount();
+	ReportPolicy& GetGustReportPolicy() { return gustReportPolicy; }
+	ReportPolicy& GetMeanReportPolicy() { return meanReportPolicy; }
+	ReportPolicy& GetBeaufortReportPolicy() { return beaufortReportPolicy; }
+	WindSpeed(const uint8_t InterruptPin, const WINDPULSECOUNTER_TYPE CounterType = WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR);
 	~WindSpeed();
 	void Process();	
 	
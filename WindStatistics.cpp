@@ -0,0 +1,154 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WindStatistics.h"
+
+WindStatistics::WindStatistics(const uint16_t& Capacity)
+{
+    Resize(Capacity);
+}
+
+WindStatistics::~WindStatistics()
+{
+    if (samples != NULL)
+    {
+        delete[] samples;
+        samples = NULL;
+    }
+}
+
+void WindStatistics::Resize(const uint16_t& Capacity)
+{
+    if (samples != NULL)
+    {
+        delete[] samples;
+        samples = NULL;
+    }
+    capacity = (Capacity == 0) ? 1 : Capacity;
+    samples = new unsigned int[capacity];
+    for (uint8_t i = 0; i < windowCount; i++)
+    {
+        if (windowLength[i] > capacity)
+        {
+            windowLength[i] = capacity;
+        }
+    }
+    Clear();
+}
+
+void WindStatistics::Clear()
+{
+    for (uint16_t i = 0; i < capacity; i++)
+    {
+        samples[i] = 0;
+    }
+    head = 0;
+    for (uint8_t i = 0; i < windowCount; i++)
+    {
+        windowSum[i] = 0;
+    }
+}
+
+int8_t WindStatistics::AddWindow(const String& Name, const uint16_t& Length)
+{
+    if (windowCount >= WINDSTATISTICS_MAX_WINDOWS || Length == 0 || Length > capacity)
+    {
+        return -1;
+    }
+    windowName[windowCount] = Name;
+    windowLength[windowCount] = Length;
+    windowSum[windowCount] = CalculateSum(Length);
+    return windowCount++;
+}
+
+bool WindStatistics::SetWindowLength(const uint8_t& Window, const uint16_t& Length)
+{
+    if (Window >= windowCount || Length == 0 || Length > capacity)
+    {
+        return false;
+    }
+    //Only on reconfiguration the window is summed again
+    windowLength[Window] = Length;
+    windowSum[Window] = CalculateSum(Length);
+    return true;
+}
+
+unsigned long WindStatistics::CalculateSum(const uint16_t& Length)
+{
+    unsigned long sum = 0;
+    for (uint16_t age = 0; age < Length; age++)
+    {
+        sum += GetSample(age);
+    }
+    return sum;
+}
+
+void WindStatistics::AddSample(const unsigned int& Value)
+{
+    for (uint8_t i = 0; i < windowCount; i++)
+    {
+        //The sample leaving the window is windowLength positions behind the write position
+        uint16_t leaving = (head + capacity - windowLength[i]) % capacity;
+        windowSum[i] = windowSum[i] - samples[leaving] + Value;
+    }
+    samples[head] = Value;
+    head++;
+    if (head >= capacity)
+    {
+        head = 0;
+    }
+}
+
+unsigned int WindStatistics::GetAverage(const uint8_t& Window)
+{
+    if (Window >= windowCount)
+    {
+        return 0;
+    }
+    return (unsigned int)(windowSum[Window] / (unsigned long)windowLength[Window]);
+}
+
+unsigned long WindStatistics::GetSum(const uint8_t& Window)
+{
+    if (Window >= windowCount)
+    {
+        return 0;
+    }
+    return windowSum[Window];
+}
+
+unsigned int WindStatistics::GetSample(const uint16_t& Age)
+{
+    if (Age >= capacity)
+    {
+        return 0;
+    }
+    return samples[(head + capacity - 1 - Age) % capacity];
+}
+
+uint16_t WindStatistics::GetWindowLength(const uint8_t& Window)
+{
+    if (Window >= windowCount)
+    {
+        return 0;
+    }
+    return windowLength[Window];
+}
+
+String WindStatistics::GetWindowName(const uint8_t& Window)
+{
+    if (Window >= windowCount)
+    {
+        return String();
+    }
+    return windowName[Window];
+}
@@ -0,0 +1,56 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Custom build Weather Station
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WindStatistics.h
+
+#ifndef _WINDSTATISTICS_h
+#define _WINDSTATISTICS_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+	#include "arduino.h"
+#else
+	#include "WProgram.h"
+#endif
+
+#define WINDSTATISTICS_MAX_WINDOWS 6
+
+//Ring buffer of wind samples with a running sum per named window.
+//Adding a sample costs one add and one subtract per window, independent of the window length.
+class WindStatistics
+{
+private:
+	unsigned int* samples = NULL;
+	uint16_t capacity = 0;
+	uint16_t head = 0; //Next write position
+	uint8_t windowCount = 0;
+	String windowName[WINDSTATISTICS_MAX_WINDOWS];
+	uint16_t windowLength[WINDSTATISTICS_MAX_WINDOWS] = { 0 };
+	unsigned long windowSum[WINDSTATISTICS_MAX_WINDOWS] = { 0 };
+	unsigned long CalculateSum(const uint16_t& Length);
+public:
+	WindStatistics(const uint16_t& Capacity);
+	~WindStatistics();
+	void Resize(const uint16_t& Capacity);
+	void Clear();
+	int8_t AddWindow(const String& Name, const uint16_t& Length);
+	bool SetWindowLength(const uint8_t& Window, const uint16_t& Length);
+	void AddSample(const unsigned int& Value);
+	unsigned int GetAverage(const uint8_t& Window);
+	unsigned long GetSum(const uint8_t& Window);
+	unsigned int GetSample(const uint16_t& Age); //Age 0 is the newest sample
+	uint16_t GetWindowLength(const uint8_t& Window);
+	String GetWindowName(const uint8_t& Window);
+	uint8_t GetWindowCount() { return windowCount; }
+	uint16_t GetCapacity() { return capacity; }
+};
+
+#endif
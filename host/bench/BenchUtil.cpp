@@ -0,0 +1,83 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "BenchUtil.h"
+#include <cstdlib>
+#include <new>
+#include <malloc.h>
+
+static uint64_t heapAllocations = 0;
+static uint64_t heapBytes = 0;
+static int64_t heapInUse = 0;
+static int64_t heapPeak = 0;
+
+static void* CountedAlloc(size_t size)
+{
+    void* p = malloc(size == 0 ? 1 : size);
+    if (p == NULL)
+    {
+        throw std::bad_alloc();
+    }
+    heapAllocations++;
+    heapBytes += size;
+    heapInUse += (int64_t)malloc_usable_size(p);
+    if (heapInUse > heapPeak)
+    {
+        heapPeak = heapInUse;
+    }
+    return p;
+}
+
+static void CountedFree(void* p)
+{
+    if (p != NULL)
+    {
+        heapInUse -= (int64_t)malloc_usable_size(p);
+        free(p);
+    }
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void operator delete(void* p) noexcept { CountedFree(p); }
+void operator delete[](void* p) noexcept { CountedFree(p); }
+void operator delete(void* p, size_t) noexcept { CountedFree(p); }
+void operator delete[](void* p, size_t) noexcept { CountedFree(p); }
+
+namespace BenchUtil
+{
+    HeapCounters GetHeapCounters()
+    {
+        HeapCounters c;
+        c.allocations = heapAllocations;
+        c.bytes = heapBytes;
+        c.inUse = heapInUse;
+        c.peak = heapPeak;
+        return c;
+    }
+
+    void ResetHeapPeak()
+    {
+        heapPeak = heapInUse;
+    }
+
+    void PrintHeader(const char* title)
+    {
+        printf("\n%s\n", title);
+        printf("%-44s %12s %12s %10s %12s\n", "benchmark", "calls", "ns/call", "allocs", "bytes/call");
+    }
+
+    void Print(const Result& r)
+    {
+        printf("%-44s %12llu %12.1f %10.3f %12.1f\n", r.name, (unsigned long long)r.calls, r.nsPerCall, r.allocationsPerCall, r.bytesPerCall);
+    }
+}
@@ -0,0 +1,68 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// BenchUtil.h
+// Timing and heap accounting for the host micro benchmarks. BenchUtil.cpp replaces the global operator new
+// and delete, so every heap allocation of the firmware code (String included) is counted.
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include <cstdio>
+
+namespace BenchUtil
+{
+	struct HeapCounters
+	{
+		uint64_t allocations;
+		uint64_t bytes;
+		int64_t inUse;
+		int64_t peak;
+	};
+
+	HeapCounters GetHeapCounters();
+	//Restarts the peak tracking at the current heap usage
+	void ResetHeapPeak();
+
+	struct Result
+	{
+		const char* name;
+		uint64_t calls;
+		double nsPerCall;
+		double allocationsPerCall;
+		double bytesPerCall;
+	};
+
+	template <typename Fn> Result Run(const char* name, const uint64_t& calls, Fn fn)
+	{
+		HeapCounters before = GetHeapCounters();
+		auto start = std::chrono::steady_clock::now();
+		for (uint64_t i = 0; i < calls; i++)
+		{
+			fn(i);
+		}
+		auto stop = std::chrono::steady_clock::now();
+		HeapCounters after = GetHeapCounters();
+
+		Result r;
+		r.name = name;
+		r.calls = calls;
+		r.nsPerCall = (double)std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / (double)calls;
+		r.allocationsPerCall = (double)(after.allocations - before.allocations) / (double)calls;
+		r.bytesPerCall = (double)(after.bytes - before.bytes) / (double)calls;
+		return r;
+	}
+
+	void PrintHeader(const char* title);
+	void Print(const Result& r);
+}
@@ -0,0 +1,145 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// ConversionBench.cpp
+// Compares the compile time conversion tables with the libm formulas they replace, first for exactness over
+// the full input range (exit code 1 on any difference), then for speed.
+
+#include "arduino.h"
+#include "BenchUtil.h"
+#include "ConversionTables.h"
+#include "WindSpeed.h"
+#include <cfloat>
+
+static volatile float benchSink = 0;
+
+//The formulas as they were in WindSpeed, BrightnessSensor and Buienradar
+static uint8_t FormulaBeaufort(const float& Speed)
+{
+    uint8_t b = pow(pow((Speed / 0.836), 0.33), 2);
+    return b;
+}
+
+static uint16_t FormulaLux(const uint16_t& BrightnessLightLevel)
+{
+    return BrightnessLightLevel + pow((BrightnessLightLevel / 15), 2);
+}
+
+static float FormulaRain(const float& val)
+{
+    return pow(10, ((val - 109) / 32));
+}
+
+static uint64_t mismatches = 0;
+
+static void CheckBeaufort(const float& speed)
+{
+    uint8_t expected = FormulaBeaufort(speed);
+    uint8_t actual = ConversionTables::Beaufort(speed);
+    if (expected != actual)
+    {
+        if (mismatches++ < 10)
+        {
+            printf("Beaufort mismatch at %.9g m/s: formula %u, table %u\n", speed, expected, actual);
+        }
+    }
+}
+
+static void VerifyBeaufort()
+{
+    uint64_t checks = 0;
+    //Every speed the firmware can produce: a whole pulse count average times RPM_FACTOR
+    for (unsigned int count = 0; count < 4000; count++)
+    {
+        CheckBeaufort((float)(RPM_FACTOR * (float)count));
+        checks++;
+    }
+    //Dense sweep and the float neighbours of every threshold
+    for (float speed = 0; speed < 160; speed += 0.0007f)
+    {
+        CheckBeaufort(speed);
+        checks++;
+    }
+    for (uint8_t b = 1; b <= CONVERSION_BEAUFORT_TABLE_SIZE; b++)
+    {
+        float speed = (float)ConversionTables::BeaufortThreshold(b);
+        for (int i = 0; i < 256; i++)
+        {
+            speed = nextafterf(speed, 0);
+        }
+        for (int i = 0; i < 512; i++)
+        {
+            CheckBeaufort(speed);
+            speed = nextafterf(speed, FLT_MAX);
+            checks++;
+        }
+    }
+    printf("Beaufort: %llu inputs checked\n", (unsigned long long)checks);
+}
+
+static void VerifyLux()
+{
+    for (uint32_t raw = 0; raw <= 0xFFFF; raw++)
+    {
+        uint16_t expected = FormulaLux((uint16_t)raw);
+        uint16_t actual = ConversionTables::Lux((uint16_t)raw);
+        if (expected != actual && mismatches++ < 10)
+        {
+            printf("Lux mismatch at raw %u: formula %u, table %u\n", raw, expected, actual);
+        }
+    }
+    printf("Lux: 65536 inputs checked\n");
+}
+
+static void VerifyRain()
+{
+    for (int intensity = -16; intensity < CONVERSION_RAIN_TABLE_SIZE + 16; intensity++)
+    {
+        float expected = FormulaRain((float)intensity);
+        float actual = ConversionTables::RainAmount(intensity);
+        if (expected != actual && mismatches++ < 10)
+        {
+            printf("Rain mismatch at intensity %d: formula %.9g, table %.9g\n", intensity, expected, actual);
+        }
+    }
+    printf("Rain: %d inputs checked\n", CONVERSION_RAIN_TABLE_SIZE + 32);
+}
+
+int main()
+{
+    VerifyBeaufort();
+    VerifyLux();
+    VerifyRain();
+    printf("%llu mismatches\n", (unsigned long long)mismatches);
+
+    BenchUtil::PrintHeader("Conversions");
+    BenchUtil::Print(BenchUtil::Run("Beaufort formula (pow)", 2000000, [&](uint64_t i) {
+        benchSink = FormulaBeaufort((float)(RPM_FACTOR * (float)(i % 1000)));
+    }));
+    BenchUtil::Print(BenchUtil::Run("Beaufort table", 2000000, [&](uint64_t i) {
+        benchSink = ConversionTables::Beaufort((float)(RPM_FACTOR * (float)(i % 1000)));
+    }));
+    BenchUtil::Print(BenchUtil::Run("Lux formula (pow)", 2000000, [&](uint64_t i) {
+        benchSink = FormulaLux((uint16_t)(i % 4096));
+    }));
+    BenchUtil::Print(BenchUtil::Run("Lux integer", 2000000, [&](uint64_t i) {
+        benchSink = ConversionTables::Lux((uint16_t)(i % 4096));
+    }));
+    BenchUtil::Print(BenchUtil::Run("Rain formula (pow)", 2000000, [&](uint64_t i) {
+        benchSink = FormulaRain((float)(i % 256));
+    }));
+    BenchUtil::Print(BenchUtil::Run("Rain table", 2000000, [&](uint64_t i) {
+        benchSink = ConversionTables::RainAmount((int)(i % 256));
+    }));
+
+    return mismatches == 0 ? 0 : 1;
+}
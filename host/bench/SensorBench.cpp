@@ -0,0 +1,1049 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// SensorBench.cpp
+// Host micro benchmarks for the Process() hot paths of the sensor classes.
+// "idle" calls return before the refresh interval has passed, "due" calls advance the virtual clock so
+// every call performs a full sample. Wall clock nanoseconds are host time, allocations match the firmware.
+
+#include "arduino.h"
+#include "BenchUtil.h"
+#include "WindSpeed.h"
+#include "WindStatistics.h"
+#include "WindDistribution.h"
+#include "BrightnessSensor.h"
+#include "LuxCalibration.h"
+#include "ReportPolicy.h"
+#include "DerivedWeather.h"
+#include "TemperatureSensor.h"
+#include "HostOneWire.h"
+#include "BuienradarExpectedRain.h"
+#include "BuienradarHTTPClient.h"
+#include "RainTextParser.h"
+#include "ConversionTables.h"
+#include "DnsCache.h"
+
+#define BENCH_PIN_WINDSPEED 34
+#define BENCH_PIN_ONEWIRE 27
+#define BENCH_PIN_LIGHT A0
+
+static volatile float benchSink = 0;
+
+static void OnFloat(const float& v) { benchSink = v; }
+static void OnUint8(const uint8_t& v) { benchSink = v; }
+static void OnUint16(const uint16_t& v) { benchSink = v; }
+static uint32_t brightnessCallbacks = 0;
+static void OnBrightnessCount(const uint16_t& v) { benchSink = v; brightnessCallbacks++; }
+static void OnRain(const bool& isRain, const float& amount) { benchSink = isRain ? amount : -amount; }
+
+String BuildRainText(const uint8_t& rainyLines)
+{
+    //Buienradar raintext: 24 lines of "intensity|HH:MM", 5 minutes apart
+    String body;
+    for (int i = 0; i < 24; i++)
+    {
+        char line[16];
+        int minutes = 12 * 60 + i * 5;
+        snprintf(line, sizeof(line), "%03d|%02d:%02d\r\n", i < rainyLines ? 77 + i * 4 : 0, minutes / 60, minutes % 60);
+        body += line;
+    }
+    return body;
+}
+
+static void BenchWindSpeed()
+{
+    HostHal::Reset();
+    WindSpeed wind(BENCH_PIN_WINDSPEED);
+    wind.SetOnWindGustsChangeEvent(OnFloat);
+    wind.SetOnWindBeaufortChangeEvent(OnUint8);
+
+    BenchUtil::PrintHeader("WindSpeed");
+    BenchUtil::Print(BenchUtil::Run("WindSpeed::Process idle", 1000000, [&](uint64_t) {
+        wind.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("WindSpeed::Process due", 200000, [&](uint64_t i) {
+        HostHal::PulsePin(BENCH_PIN_WINDSPEED, (uint32_t)(i % 97));
+        HostHal::AdvanceMillis(WIND_REFRESH_INTERVAL);
+        wind.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("WindSpeed::GetValues", 20000, [&](uint64_t) {
+        benchSink = (float)wind.GetValues().length();
+    }));
+}
+
+static void BenchWindPulseCounters()
+{
+    //CPU time of the wind pipeline per 10 second window: the pulses of the window and the
+    //Process() calls of the main loop (about 40 per window). ISR entry/exit is not part of the host time,
+    //the interrupt count shows what the ESP32 pays on top of that.
+    BenchUtil::PrintHeader("WindPulseCounter, per 10 second window");
+    const uint32_t rates[] = { 0, 50, 500 };
+    const WINDPULSECOUNTER_TYPE types[] = { WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR, WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT };
+    const uint8_t slices = 40;
+    for (WINDPULSECOUNTER_TYPE type : types)
+    {
+        for (uint32_t rate : rates)
+        {
+            HostHal::Reset();
+            WindSpeed wind(BENCH_PIN_WINDSPEED, type);
+            char name[64];
+            snprintf(name, sizeof(name), "%s %u Hz", type == WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT ? "PCNT" : "ISR", rate);
+            BenchUtil::Print(BenchUtil::Run(name, 5000, [&](uint64_t) {
+                for (uint8_t s = 0; s < slices; s++)
+                {
+                    //Edges of a slice are spread evenly over it, the hardware counter costs no CPU, the ISR runs per edge
+                    uint32_t total = rate * WIND_REFRESH_INTERVAL / 1000;
+                    uint32_t edges = (total * (s + 1)) / slices - (total * s) / slices;
+                    uint32_t sliceUs = (WIND_REFRESH_INTERVAL * 1000) / slices;
+                    uint32_t periodUs = (edges == 0) ? 0 : sliceUs / edges;
+                    HostHal::PulsePin(BENCH_PIN_WINDSPEED, edges, periodUs);
+                    HostHal::AdvanceMicros(sliceUs - edges * periodUs);
+                    wind.Process();
+                }
+            }));
+            printf("%-44s %12.1f interrupts/window, gust %.1f m/s\n", "", (double)HostHal::GetInterruptCount() / 5000.0, wind.GetWindGusts());
+        }
+    }
+}
+
+static void BenchWindDebounce()
+{
+    //A reed switch that bounces twice, 200us apart, on every closing: only the first edge may count
+    BenchUtil::PrintHeader("WindPulseCounterISR debounce");
+    HostHal::Reset();
+    WindSpeed wind(BENCH_PIN_WINDSPEED);
+    const uint32_t pulses = 200000;
+    BenchUtil::Print(BenchUtil::Run("ISR edge with bounce, 20 Hz", pulses, [&](uint64_t) {
+        HostHal::PulsePin(BENCH_PIN_WINDSPEED, 3, 200);
+        HostHal::AdvanceMicros(50000 - 600);
+    }));
+    wind.Process();
+    printf("%-44s %12u pulses, %u rejected edges\n", "", wind.currentWindFaneReading, wind.GetRejectedPulseCount());
+}
+
+static void BenchWindCounterFallback()
+{
+    //PCNT can not debounce, asking for a debounce switches to the interrupt counter
+    HostHal::Reset();
+    WindSpeed pcntWind(BENCH_PIN_WINDSPEED, WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT);
+    if (!pcntWind.SetDebounceMicros(0) || pcntWind.GetPulseCounterType() != WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_PCNT ||
+        !pcntWind.SetDebounceMicros(WINDPULSECOUNTER_DEBOUNCE_US) || pcntWind.GetPulseCounterType() != WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR)
+    {
+        printf("WindSpeed: unexpected counter after SetDebounceMicros on PCNT\n");
+    }
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        HostHal::PulsePin(BENCH_PIN_WINDSPEED, 3, 200);
+        HostHal::AdvanceMicros(50000 - 600);
+    }
+    HostHal::AdvanceMillis(WIND_REFRESH_INTERVAL);
+    pcntWind.Process();
+    if (pcntWind.currentWindFaneReading != 10 || pcntWind.GetRejectedPulseCount() != 20)
+    {
+        printf("WindSpeed: unexpected %u pulses after switching from PCNT\n", pcntWind.currentWindFaneReading);
+    }
+}
+
+static void BenchInstantWindSpeed()
+{
+    //Low speeds: a 10 second bucket holds only a few pulses, the pulse period resolves the speed in between.
+    //Process() runs every 100ms as in the main loop, the worst error is over all calls after the first 10 seconds.
+    //The cups of a real anemometer are not evenly spaced, the second pass alternates the intervals by 25%.
+    BenchUtil::PrintHeader("Instant wind speed from the pulse period");
+    const uint32_t periodsUs[] = { 2700000, 1300000, 730000, 410000, 97000 };
+    for (uint8_t uneven = 0; uneven < 2; uneven++)
+    for (uint32_t periodUs : periodsUs)
+    {
+        HostHal::Reset();
+        WindSpeed wind(BENCH_PIN_WINDSPEED);
+        float trueMS = (float)(RPM_FACTOR * WIND_REFRESH_INTERVAL * 1000.0 / periodUs);
+        float worstInstantMS = 0;
+        float worstCountMS = 0;
+        uint64_t nextPulseUs = periodUs;
+        uint32_t pulseCount = 0;
+        for (uint64_t t = 0; t < 120000000; t += 100000)
+        {
+            while (nextPulseUs <= t)
+            {
+                HostHal::SetMicros(nextPulseUs);
+                HostHal::PulsePin(BENCH_PIN_WINDSPEED);
+                nextPulseUs += (uneven && (++pulseCount & 1)) ? periodUs * 3 / 4 : (uneven ? periodUs * 5 / 4 : periodUs);
+            }
+            HostHal::SetMicros(t);
+            wind.Process();
+            if (t > 10000000)
+            {
+                worstInstantMS = std::max(worstInstantMS, (float)fabs(wind.GetInstantWindMS() - trueMS));
+                worstCountMS = std::max(worstCountMS, (float)fabs(wind.currentWindFaneReading * RPM_FACTOR - trueMS));
+            }
+        }
+        printf("%-28s %8.3f m/s: worst error instant %.3f m/s, 10 s count %.3f m/s\n", periodUs != periodsUs[0] ? "" : (uneven ? "Uneven, 25%" : "Pulse period 2.7s .. 97ms"),
+            trueMS, worstInstantMS, worstCountMS);
+    }
+}
+
+static void BenchWindStatistics()
+{
+    //Cost per sample must not depend on the window length
+    BenchUtil::PrintHeader("WindStatistics");
+    const uint16_t lengths[] = { 6, 60, 360, 3600 };
+    for (uint16_t length : lengths)
+    {
+        WindStatistics statistics(3600);
+        statistics.AddWindow(String("mean"), length);
+        statistics.AddWindow(String("gust"), 6);
+        char name[64];
+        snprintf(name, sizeof(name), "WindStatistics::AddSample window %u", length);
+        BenchUtil::Print(BenchUtil::Run(name, 2000000, [&](uint64_t i) {
+            statistics.AddSample((unsigned int)(i % 97));
+            benchSink = (float)statistics.GetAverage(0);
+        }));
+    }
+}
+
+static void BenchWindDistribution()
+{
+    //Update is O(1) for every window length, the percentile query scans the fixed histogram
+    BenchUtil::PrintHeader("WindDistribution");
+    const uint16_t lengths[] = { 60, 360, 3600 };
+    for (uint16_t length : lengths)
+    {
+        WindStatistics statistics(3600);
+        statistics.AddWindow(String("window"), length);
+        WindDistribution distribution(WINDSPEED_HISTOGRAM_BUCKET);
+        for (uint16_t i = 0; i < length; i++)
+        {
+            distribution.Insert(0);
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "WindDistribution::Replace window %u", length);
+        BenchUtil::Print(BenchUtil::Run(name, 2000000, [&](uint64_t i) {
+            unsigned int value = (unsigned int)((i * 31) % 400);
+            distribution.Replace(value, statistics.GetSample(length - 1));
+            statistics.AddSample(value);
+        }));
+        snprintf(name, sizeof(name), "WindDistribution P50/P90/P99 window %u", length);
+        BenchUtil::Print(BenchUtil::Run(name, 200000, [&](uint64_t) {
+            benchSink = distribution.GetPercentile(50) + distribution.GetPercentile(90) + distribution.GetPercentile(99);
+        }));
+        snprintf(name, sizeof(name), "WindDistribution stddev/TI window %u", length);
+        BenchUtil::Print(BenchUtil::Run(name, 2000000, [&](uint64_t) {
+            benchSink = distribution.GetStdDev() + distribution.GetTurbulenceIntensity();
+        }));
+    }
+}
+
+static void BenchBrightness()
+{
+    HostHal::Reset();
+    BrightnessSensor brightness(BENCH_PIN_LIGHT);
+    brightness.SetOnLuxValueChangeEvent(OnUint16);
+
+    BenchUtil::PrintHeader("BrightnessSensor");
+    BenchUtil::Print(BenchUtil::Run("BrightnessSensor::Process idle", 1000000, [&](uint64_t) {
+        brightness.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("BrightnessSensor::Process due", 200000, [&](uint64_t i) {
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, (uint16_t)((i * 37) % 4096));
+        HostHal::AdvanceMillis(BIGHTNESS_UPDATE_INTERVAL);
+        brightness.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("BrightnessSensor::GetBrightness", 1000000, [&](uint64_t) {
+        benchSink = brightness.GetBrightness();
+    }));
+
+    //Lux calibration: table lookup cost, and the cached value that GetBrightness returns
+    LuxCalibration calibration;
+    const char* calibrationText = "0:0,200:15,500:60,900:250,1400:900,1900:2500,2400:6000,2900:13000,3300:25000,3700:45000,4095:65000";
+    if (!calibration.Parse(calibrationText) || calibration.Convert(0) != 0 || calibration.Convert(4095) != 65000 || calibration.Convert(350) != 37 || calibration.Convert(5000) != 65000)
+    {
+        printf("LuxCalibration: unexpected conversion\n");
+    }
+    if (calibration.Parse("100:5,50:10") || calibration.Parse("100:5") || calibration.Parse("100:5,x") || calibration.GetPointCount() != 11)
+    {
+        printf("LuxCalibration: invalid table accepted\n");
+    }
+    //The longest table fits the params field, WiFiManager cuts longer input without a notice
+    String longestText;
+    for (uint16_t raw = 4096 - LUXCALIBRATION_MAX_POINTS; raw < 4096; raw++)
+    {
+        longestText += String(raw) + ":65535" + (raw < 4095 ? "," : "");
+    }
+    LuxCalibration longest;
+    if (longestText.length() > LUXCALIBRATION_FIELD_LEN || !longest.Parse(longestText.c_str()) || longest.GetPointCount() != LUXCALIBRATION_MAX_POINTS || longest.ToString() != longestText)
+    {
+        printf("LuxCalibration: longest table does not fit the params field\n");
+    }
+    BenchUtil::Print(BenchUtil::Run("LuxCalibration::Convert, 11 points", 2000000, [&](uint64_t i) {
+        benchSink = calibration.Convert((uint16_t)(i % 4096));
+    }));
+    brightness.SetLuxCalibration(calibrationText);
+    BenchUtil::Print(BenchUtil::Run("BrightnessSensor::GetBrightness, calibrated", 1000000, [&](uint64_t) {
+        benchSink = brightness.GetBrightness();
+    }));
+    brightness.SetLuxCalibration("");
+
+    HostHal::Reset();
+    BrightnessSensor continuous(BENCH_PIN_LIGHT, BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS);
+    continuous.SetOnLuxValueChangeEvent(OnUint16);
+    BenchUtil::Print(BenchUtil::Run("BrightnessSensor::Process due, DMA (+shim)", 200000, [&](uint64_t i) {
+        //Start of the reading, and the loop pass 30ms later that collects the oversampled result
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, (uint16_t)((i * 37) % 4096));
+        HostHal::AdvanceMillis(BIGHTNESS_UPDATE_INTERVAL);
+        continuous.Process();
+        HostHal::AdvanceMillis(30);
+        continuous.Process();
+    }));
+
+    //Conversions left in the driver buffer by adc_digi_stop() are not part of the next reading
+    HostHal::Reset();
+    {
+        BrightnessADCContinuous adc;
+        adc.Begin(BENCH_PIN_LIGHT);
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, 4000);
+        adc_digi_start();
+        HostHal::AdvanceMillis(10);
+        adc_digi_stop();
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, 1000);
+        uint16_t counts = 0;
+        uint16_t millivolts = 0;
+        bool isRead = adc.StartReading();
+        HostHal::AdvanceMillis(30);
+        isRead = isRead && adc.GetReading(counts, millivolts);
+        if (!isRead || counts < 995 || counts > 1005)
+        {
+            printf("BrightnessADCContinuous: unexpected reading %u with conversions of the previous reading\n", counts);
+        }
+    }
+    //A DMA that does not start or stops delivering: the sensor keeps reading with analogRead
+    for (uint8_t fault = 0; fault < 2; fault++)
+    {
+        HostHal::Reset();
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, 1500);
+        BrightnessSensor faulty(BENCH_PIN_LIGHT, BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS);
+        HostHal::SetAdcStartFailure(fault == 0);
+        HostHal::SetAdcStalled(fault == 1);
+        for (uint32_t pass = 0; pass < 240; pass++)
+        {
+            HostHal::AdvanceMillis(250);
+            faulty.Process();
+        }
+        if (faulty.GetAdcType() != BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_ANALOGREAD || faulty.GetMillivolts() != 1208)
+        {
+            printf("BrightnessSensor: unexpected %s DMA, %u mV\n", fault == 0 ? "failed" : "stalled", faulty.GetMillivolts());
+        }
+    }
+
+    //Cost of a reading per filter, and callbacks caused by short spikes (headlights, reflections):
+    //constant light with a reading at full scale every 5 minutes
+    const BRIGHTNESSFILTER_TYPE filters[] = { BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_AVERAGE, BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_MEDIAN, BRIGHTNESSFILTER_TYPE::BRIGHTNESSFILTER_TYPE_TRIMMED_MEAN };
+    const char* filterNames[] = { "average", "median", "trimmed mean" };
+    for (BRIGHTNESSFILTER_TYPE filter : filters)
+    {
+        HostHal::Reset();
+        BrightnessSensor filtered(BENCH_PIN_LIGHT);
+        filtered.SetFilter(filter);
+        filtered.SetOnLuxValueChangeEvent(OnUint16);
+        char name[64];
+        snprintf(name, sizeof(name), "BrightnessSensor::Process due, %s", filterNames[filter]);
+        BenchUtil::Print(BenchUtil::Run(name, 200000, [&](uint64_t i) {
+            HostHal::SetAnalogValue(BENCH_PIN_LIGHT, (uint16_t)((i * 37) % 4096));
+            HostHal::AdvanceMillis(BIGHTNESS_UPDATE_INTERVAL);
+            filtered.Process();
+        }));
+
+        HostHal::Reset();
+        BrightnessSensor spiky(BENCH_PIN_LIGHT);
+        spiky.SetFilter(filter);
+        spiky.SetOnLuxValueChangeEvent(OnBrightnessCount);
+        brightnessCallbacks = 0;
+        for (uint32_t reading = 0; reading < 86400000 / (BIGHTNESS_UPDATE_INTERVAL); reading++)
+        {
+            HostHal::SetAnalogValue(BENCH_PIN_LIGHT, (reading % 40 == 39) ? 4095 : 1500);
+            HostHal::AdvanceMillis(BIGHTNESS_UPDATE_INTERVAL);
+            spiky.Process();
+        }
+        printf("%-44s %12u callbacks/day with a spike every 5 minutes\n", "", brightnessCallbacks);
+    }
+
+    //Constant light with +-60 counts of noise on every conversion: callbacks per day that are only noise
+    const BRIGHTNESSADC_TYPE types[] = { BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_ANALOGREAD, BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS };
+    for (BRIGHTNESSADC_TYPE type : types)
+    {
+        HostHal::Reset();
+        HostHal::SetAnalogValue(BENCH_PIN_LIGHT, 2000);
+        HostHal::SetAnalogNoise(BENCH_PIN_LIGHT, 60);
+        BrightnessSensor noisy(BENCH_PIN_LIGHT, type);
+        noisy.SetOnLuxValueChangeEvent(OnBrightnessCount);
+        brightnessCallbacks = 0;
+        for (uint32_t t = 0; t < 86400; t++)
+        {
+            HostHal::AdvanceMillis(1000);
+            noisy.Process();
+        }
+        printf("%-44s %12u callbacks/day, %llu conversions/day\n", type == BRIGHTNESSADC_TYPE::BRIGHTNESSADC_TYPE_CONTINUOUS ? "Noise +-60, DMA x512" : "Noise +-60, analogRead",
+            brightnessCallbacks, (unsigned long long)HostHal::GetAdcConversionCount());
+    }
+}
+
+static void BenchReportPolicy()
+{
+    HostHal::Reset();
+    ReportPolicy policy(0.5f, 0.1f, 0.2f, 60000, 600000);
+    float held = 0;
+    //First value, inside the deadband, outside it, reversal inside the hysteresis, held by the minimum interval, periodic
+    bool ok = policy.Update(10) && !policy.Update(10.9f) && !policy.Poll(held);
+    HostHal::AdvanceMillis(60000);
+    ok = ok && policy.Update(11.2f) && !policy.Update(10.0f);
+    HostHal::AdvanceMillis(60000);
+    ok = ok && policy.Update(9.6f) && !policy.Update(12.0f);
+    HostHal::AdvanceMillis(59999);
+    ok = ok && !policy.Poll(held);
+    HostHal::AdvanceMillis(1);
+    ok = ok && policy.Poll(held) && held == 12.0f;
+    HostHal::AdvanceMillis(600000);
+    ok = ok && policy.Poll(held) && held == 12.0f && policy.GetReportCount() == 5;
+    if (!ok)
+    {
+        printf("ReportPolicy: unexpected decision\n");
+    }
+
+    BenchUtil::PrintHeader("ReportPolicy");
+    ReportPolicy everyChange;
+    BenchUtil::Print(BenchUtil::Run("ReportPolicy::Update, every change", 2000000, [&](uint64_t i) {
+        benchSink = everyChange.Update((float)(i % 100));
+    }));
+    ReportPolicy deadband(0.5f, 0.1f, 0.2f, 0, 0);
+    BenchUtil::Print(BenchUtil::Run("ReportPolicy::Update, deadband", 2000000, [&](uint64_t i) {
+        benchSink = deadband.Update((float)(i % 100) * 0.01f);
+    }));
+    BenchUtil::Print(BenchUtil::Run("ReportPolicy::Poll", 2000000, [&](uint64_t) {
+        benchSink = deadband.Poll(held);
+    }));
+}
+
+static void BenchDerivedWeather()
+{
+    //Reference values: NWS wind chill and heat index tables, Magnus dew point
+    if (fabsf(DerivedWeather::WindChill(-10.0f, 30.0f) - -19.5f) > 0.1f || fabsf(DerivedWeather::DewPoint(20.0f, 50.0f) - 9.3f) > 0.1f ||
+        fabsf(DerivedWeather::HeatIndex(32.2f, 70.0f) - 41.1f) > 0.3f || DerivedWeather::WindChill(15.0f, 30.0f) != 15.0f)
+    {
+        printf("DerivedWeather: unexpected reference values\n");
+    }
+
+    //Inputs fed like the station callbacks: a changed temperature recomputes both quantities, an unchanged one nothing
+    DerivedWeather derived;
+    derived.SetOnDerivedValueChangeEvent([](const DERIVEDWEATHER_QUANTITY&, const float& v) { benchSink = v; });
+    derived.SetTemperature(5.0f);
+    derived.SetWindSpeed(8.0f);
+    derived.Process();
+    derived.SetTemperature(5.0f);
+    derived.Process();
+    derived.SetHumidity(80.0f);
+    derived.Process();
+    if (derived.GetComputeCount(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_WINDCHILL) != 1 || derived.GetComputeCount(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE) != 2 ||
+        derived.GetComputeCount(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_DEWPOINT) != 1 || derived.IsAvailable(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_HEATINDEX) != true)
+    {
+        printf("DerivedWeather: unexpected recomputation\n");
+    }
+
+    BenchUtil::PrintHeader("DerivedWeather");
+    BenchUtil::Print(BenchUtil::Run("DerivedWeather::Process unchanged", 2000000, [&](uint64_t) {
+        derived.SetTemperature(5.0f);
+        derived.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("DerivedWeather::Process temperature changed", 2000000, [&](uint64_t i) {
+        derived.SetTemperature((float)(i % 200) * 0.1f - 10.0f);
+        derived.Process();
+    }));
+}
+
+static void BenchTemperature()
+{
+    HostHal::Reset();
+    TemperatureSensor temperature(BENCH_PIN_ONEWIRE);
+    temperature.SetOnTemperatureChangeEvent(OnFloat);
+
+    BenchUtil::PrintHeader("TemperatureSensor");
+    BenchUtil::Print(BenchUtil::Run("TemperatureSensor::Process idle", 1000000, [&](uint64_t) {
+        temperature.Process();
+    }));
+    BenchUtil::Print(BenchUtil::Run("TemperatureSensor::Process due", 200000, [&](uint64_t i) {
+        HostHal::SetProbeTemperature(10.0f + (float)(i % 50) * 0.1f);
+        HostHal::AdvanceMillis(TEMPERATURE_REFRESH_INTERVAL);
+        temperature.Process();
+        HostHal::AdvanceMillis(TEMPERATURE_CONVERSION_MARGIN + 750);
+        temperature.Process();
+        temperature.Process();
+    }));
+
+    //Three probes on one bus: bus searches and scratchpad reads per day, once enumerated and read by ROM
+    HostHal::Reset();
+    HostHal::SetProbeTemperature(0, 8.0f);
+    HostHal::SetProbeTemperature(1, 12.5f);
+    HostHal::SetProbeTemperature(2, 15.25f);
+    TemperatureSensor multiProbe(BENCH_PIN_ONEWIRE);
+    HostOneWire::ResetStatistics();
+    for (uint32_t pass = 0; pass < 8640000; pass++)
+    {
+        HostHal::AdvanceMillis(10);
+        multiProbe.Process();
+    }
+    if (multiProbe.GetProbeCount() != 3 || multiProbe.GetProbeTemperature(0) != 8.0f || multiProbe.GetProbeTemperature(1) != 12.5f || multiProbe.GetProbeTemperature(2) != 15.25f)
+    {
+        printf("TemperatureSensor: unexpected probe readings\n");
+    }
+    printf("%-44s %12u bus searches/day, %u scratchpad reads/day, 3 probes\n", "Cached ROM codes", HostOneWire::GetSearchCount(), HostOneWire::GetScratchpadReadCount());
+
+    //A probe added between restarts that the bus search finds first: the saved map keeps the channels
+    HostHal::Reset();
+    HostHal::SetProbeTemperature(0, 8.0f);
+    HostHal::SetProbeTemperature(2, 15.25f);
+    //The bus is enumerated by Process(), one ROM per call
+    auto scan = [](TemperatureSensor& Sensor) {
+        for (uint8_t pass = 0; pass <= TEMPERATURE_MAX_PROBES; pass++)
+        {
+            Sensor.Process();
+        }
+    };
+    String probeMap;
+    {
+        TemperatureSensor firstBoot(BENCH_PIN_ONEWIRE);
+        firstBoot.SetProbeMap("");
+        scan(firstBoot);
+        probeMap = firstBoot.GetProbeMap();
+    }
+    HostHal::SetProbeTemperature(1, 12.5f);
+    TemperatureSensor searchOrder(BENCH_PIN_ONEWIRE);
+    scan(searchOrder);
+    TemperatureSensor mapped(BENCH_PIN_ONEWIRE);
+    mapped.SetProbeMap(probeMap.c_str());
+    scan(mapped);
+    bool isMapped = mapped.IsProbeMapChanged();
+    for (uint32_t pass = 0; pass < 6000; pass++)
+    {
+        HostHal::AdvanceMillis(10);
+        mapped.Process();
+    }
+    if (!isMapped || mapped.GetProbeTemperature(0) != 8.0f || mapped.GetProbeTemperature(1) != 15.25f || mapped.GetProbeTemperature(2) != 12.5f
+        || searchOrder.GetProbeAddress(1) == mapped.GetProbeAddress(1) || mapped.SetProbeMap("28,") || mapped.SetProbeMap("x"))
+    {
+        printf("TemperatureSensor: unexpected probe channels\n");
+    }
+    printf("%-44s %12s\n", "Saved probe channels", mapped.GetProbeMap().c_str());
+
+    //Worst case loop latency over an hour of 10ms loop passes: the virtual time a single Process() call takes.
+    //The blocking read as it was: convert with wait for conversion, then find and read the probe.
+    HostHal::Reset();
+    HostHal::SetProbeTemperature(12.5f);
+    OneWire blockingBus(BENCH_PIN_ONEWIRE);
+    DallasTemperature blockingDallas(&blockingBus);
+    blockingDallas.begin();
+    unsigned long blockingCollectMillis = millis();
+    uint64_t blockingWorstUs = 0;
+    for (uint32_t pass = 0; pass < 360000; pass++)
+    {
+        uint64_t startUs = HostHal::GetMicros();
+        if (millis() - blockingCollectMillis >= TEMPERATURE_REFRESH_INTERVAL)
+        {
+            blockingCollectMillis = millis();
+            blockingDallas.requestTemperatures();
+            benchSink = blockingDallas.getTempCByIndex(0);
+        }
+        uint64_t passUs = HostHal::GetMicros() - startUs;
+        blockingWorstUs = passUs > blockingWorstUs ? passUs : blockingWorstUs;
+        HostHal::AdvanceMillis(10);
+    }
+    HostHal::Reset();
+    HostHal::SetProbeTemperature(12.5f);
+    TemperatureSensor nonBlocking(BENCH_PIN_ONEWIRE);
+    nonBlocking.SetOnTemperatureChangeEvent(OnFloat);
+    uint64_t nonBlockingWorstUs = 0;
+    for (uint32_t pass = 0; pass < 360000; pass++)
+    {
+        uint64_t startUs = HostHal::GetMicros();
+        nonBlocking.Process();
+        uint64_t passUs = HostHal::GetMicros() - startUs;
+        nonBlockingWorstUs = passUs > nonBlockingWorstUs ? passUs : nonBlockingWorstUs;
+        HostHal::AdvanceMillis(10);
+    }
+    printf("%-44s %12.1f ms worst case loop latency\n", "Blocking requestTemperatures", (double)blockingWorstUs / 1000.0);
+    printf("%-44s %12.1f ms worst case loop latency, %.2f C\n", "TemperatureSensor state machine", (double)nonBlockingWorstUs / 1000.0, nonBlocking.GetTemperature());
+}
+
+//Per resolution profile over an hour: the conversion time measured by polling the bus between handler cycles, the readings and the
+//worst loop pass. The simulated probes take the datasheet maximum conversion time.
+static void BenchTemperatureProfiles()
+{
+    BenchUtil::PrintHeader("Temperature resolution profiles, 1 hour");
+    for (uint8_t p = 0; p < TEMPERATURE_PROFILE_COUNT; p++)
+    {
+        HostHal::Reset();
+        HostHal::SetProbeTemperature(12.3f);
+        TemperatureSensor temperature(BENCH_PIN_ONEWIRE);
+        temperature.SetProfile((TEMPERATURE_PROFILE)p);
+        HostOneWire::ResetStatistics();
+        uint64_t worstUs = 0;
+        for (uint32_t pass = 0; pass < 360000; pass++)
+        {
+            HostHal::AdvanceMillis(10);
+            uint64_t startUs = HostHal::GetMicros();
+            //The loop runs Process once per handler cycle of about 250 ms, and polls the conversion every pass
+            temperature.PollConversion();
+            if (pass % 25 == 0)
+            {
+                temperature.Process();
+            }
+            uint64_t passUs = HostHal::GetMicros() - startUs;
+            worstUs = passUs > worstUs ? passUs : worstUs;
+        }
+        printf("%-44s %12lu ms conversion, %u readings, loop %.1f ms, %.4f C\n", temperature.GetProfileString().c_str(), temperature.GetMeasuredConversionMillis((TEMPERATURE_PROFILE)p),
+            HostOneWire::GetScratchpadReadCount(), (double)worstUs / 1000.0, temperature.GetTemperature());
+    }
+}
+
+//Wind pulses on the interrupt counter while the OneWire bus is busy: the bit banged time slots disable interrupts
+//for up to 70us, an edge in that window is delayed and a second one is lost. The RMT transport leaves them enabled.
+static void BenchOneWireTransport()
+{
+    BenchUtil::PrintHeader("OneWire transport, wind interrupts during 2 minutes with 3 probes");
+    const TEMPERATUREBUS_TYPE busTypes[] = { TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_BITBANG, TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT };
+    const uint32_t periods[] = { 25000, 1000, 50 }; //40Hz (about 100 km/h), 1kHz and a 20kHz stress source
+    for (uint8_t t = 0; t < 2; t++)
+    {
+        for (uint8_t p = 0; p < 3; p++)
+        {
+            HostHal::Reset();
+            HostHal::SetProbeTemperature(0, 8.0f);
+            HostHal::SetProbeTemperature(1, 12.5f);
+            HostHal::SetProbeTemperature(2, 15.25f);
+            WindSpeed wind(BENCH_PIN_WINDSPEED, WINDPULSECOUNTER_TYPE::WINDPULSECOUNTER_TYPE_ISR);
+            HostHal::SetPulseSource(BENCH_PIN_WINDSPEED, periods[p]);
+            TemperatureSensor temperature(BENCH_PIN_ONEWIRE, busTypes[t]);
+            uint64_t worstUs = 0;
+            for (uint32_t pass = 0; pass < 12000; pass++)
+            {
+                HostHal::AdvanceMillis(10);
+                uint64_t startUs = HostHal::GetMicros();
+                temperature.Process();
+                uint64_t passUs = HostHal::GetMicros() - startUs;
+                worstUs = passUs > worstUs ? passUs : worstUs;
+                wind.Process();
+            }
+            if (temperature.GetProbeCount() != 3 || temperature.GetProbeTemperature(0) != 8.0f || temperature.GetProbeTemperature(1) != 12.5f || temperature.GetProbeTemperature(2) != 15.25f)
+            {
+                printf("OneWire transport: unexpected probe readings\n");
+            }
+            if (temperature.GetBusType() == TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT && HostHal::GetDroppedInterruptCount() + HostHal::GetDelayedInterruptCount() > 0)
+            {
+                printf("OneWire transport: RMT bus disturbed the wind interrupts\n");
+            }
+            char name[64];
+            snprintf(name, sizeof(name), "%s, edge every %uus", temperature.GetBusType() == TEMPERATUREBUS_TYPE::TEMPERATUREBUS_TYPE_RMT ? "RMT" : "Bit banged", periods[p]);
+            printf("%-44s %12llu edges, %llu dropped, %llu delayed up to %lluus, loop %.1f ms\n", name, (unsigned long long)HostHal::GetPulseSourceEdgeCount(),
+                (unsigned long long)HostHal::GetDroppedInterruptCount(), (unsigned long long)HostHal::GetDelayedInterruptCount(), (unsigned long long)HostHal::GetMaxInterruptLatencyMicros(),
+                (double)worstUs / 1000.0);
+        }
+    }
+}
+
+static void BenchBuienradar()
+{
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    HostHTTPServer::SetResponse(200, BuildRainText(6));
+    Buienradar rain(String("52.22"), String("4.53"));
+    rain.SetOnRainReportEvent(OnRain);
+
+    BenchUtil::PrintHeader("Buienradar");
+    BenchUtil::Print(BenchUtil::Run("Buienradar::Process idle", 1000000, [&](uint64_t) {
+        rain.Process();
+    }));
+
+    //A poll is every Process() call from starting the request until the response is parsed
+    uint64_t processCalls = 0;
+    BenchUtil::ResetHeapPeak();
+    int64_t heapBase = BenchUtil::GetHeapCounters().inUse;
+    BenchUtil::Result poll = BenchUtil::Run("Buienradar poll (request..parse)", 20000, [&](uint64_t) {
+        HostHal::AdvanceMillis(rain.GetWaitTime() * 1000 + 1);
+        rain.Process();
+        processCalls++;
+        //While the request is pending the retry interval is scheduled
+        for (int i = 0; i < 1000 && rain.GetWaitTime() == 30; i++)
+        {
+            rain.Process();
+            processCalls++;
+        }
+    });
+    BenchUtil::Print(poll);
+    printf("%-44s %12.1f process calls/poll, peak heap %lld bytes\n", "", (double)processCalls / (double)poll.calls, (long long)(BenchUtil::GetHeapCounters().peak - heapBase));
+    if (!rain.GetLastRequestSucceeded() || rain.GetExpectedAmountOfRain() != ConversionTables::RainAmount(77))
+    {
+        printf("Buienradar: unexpected rain amount %.3f\n", rain.GetExpectedAmountOfRain());
+    }
+
+    //Lines split over arbitrary chunk boundaries parse the same as a whole payload
+    String body = BuildRainText(6);
+    RainTextParser parser;
+    const uint8_t chunkSizes[] = { 1, 7, 64 };
+    for (uint8_t c = 0; c < sizeof(chunkSizes); c++)
+    {
+        parser.Reset();
+        for (unsigned int pos = 0; pos < body.length(); pos += chunkSizes[c])
+        {
+            unsigned int length = body.length() - pos < chunkSizes[c] ? body.length() - pos : chunkSizes[c];
+            parser.Feed((const uint8_t*)body.c_str() + pos, length);
+        }
+        bool isCorrect = parser.IsValid() && parser.GetSampleCount() == 24;
+        for (uint8_t i = 0; isCorrect && i < parser.GetSampleCount(); i++)
+        {
+            isCorrect = parser.GetSample(i).intensity == (i < 6 ? 77 + i * 4 : 0) && parser.GetSample(i).minuteOfDay == 12 * 60 + i * 5;
+        }
+        if (!isCorrect)
+        {
+            printf("RainTextParser: unexpected samples with %u byte chunks\n", chunkSizes[c]);
+        }
+    }
+    //Without a Content-Length the body is collected by the HTTPClient until the connection closes
+    HostHTTPServer::SetContentLength(false);
+    BuienradarHTTPClient client;
+    client.HTTPRequestAsync("gpsgadget.buienradar.nl", 443, "/data/raintext/?lat=52.22&lon=4.53");
+    for (int i = 0; i < 1000 && client.GetAsyncStatus() == HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING; i++)
+    {
+        client.ProcessAsync();
+    }
+    if (client.GetAsyncStatus() != HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS || client.GetRainText().GetSampleCount() != 24)
+    {
+        printf("BuienradarHTTPClient: unexpected %u samples without Content-Length\n", client.GetRainText().GetSampleCount());
+    }
+    client.ReleaseAsync();
+    HostHTTPServer::SetContentLength(true);
+
+    BenchUtil::Print(BenchUtil::Run("RainTextParser::Feed (24 lines)", 200000, [&](uint64_t) {
+        parser.Reset();
+        parser.Feed((const uint8_t*)body.c_str(), body.length());
+    }));
+}
+
+//Raintext of a single shower from onsetMinute to endMinute, as Buienradar serves it at nowMinute (minutes after 12:00)
+static String BuildShowerRainText(const uint32_t& nowMinute, const uint32_t& onsetMinute, const uint32_t& endMinute)
+{
+    String body;
+    for (uint32_t i = 0; i < 24; i++)
+    {
+        char line[16];
+        uint32_t slotMinute = (nowMinute / 5) * 5 + i * 5;
+        uint32_t minuteOfDay = (12 * 60 + slotMinute) % 1440;
+        snprintf(line, sizeof(line), "%03u|%02u:%02u\r\n", slotMinute >= onsetMinute && slotMinute < endMinute ? 117u : 0u, minuteOfDay / 60, minuteOfDay % 60);
+        body += line;
+    }
+    return body;
+}
+
+static void BenchRainForecast()
+{
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    RainTextParser parser;
+    RainForecast forecast;
+    String body = BuildShowerRainText(0, 20, 45);
+    parser.Feed((const uint8_t*)body.c_str(), body.length());
+    forecast.Update(parser);
+    //117 is 1.778 mm/h, 25 minutes of it are 0.741 mm
+    if (forecast.GetMinutesToRain() != 20 || forecast.GetMinutesToRainEnd() != 45 || fabsf(forecast.GetExpectedRainMm(60) - 0.741f) > 0.001f || forecast.GetHorizonMinutes() != 120)
+    {
+        printf("RainForecast: unexpected forecast %s\n", forecast.ToString().c_str());
+    }
+    HostHal::AdvanceMillis(30 * 60000UL);
+    if (forecast.GetMinutesToRain() != 0 || forecast.GetMinutesToRainEnd() != 15 || forecast.GetHorizonMinutes() != 90)
+    {
+        printf("RainForecast: unexpected aged forecast %s\n", forecast.ToString().c_str());
+    }
+
+    //Six hours with a 40 minute shower after three hours, polled with the forecast driven schedule
+    const uint32_t onset = 180;
+    const uint32_t end = 220;
+    const uint32_t duration = 360;
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    Buienradar rain(String("52.22"), String("4.53"));
+    rain.SetOnRainReportEvent(OnRain);
+    int32_t firstWarning = -1;
+    uint32_t lastPollMinute = 0;
+    uint32_t pollAgeAtOnset = 0;
+    uint32_t servedSlot = 0xFFFFFFFF;
+    for (uint32_t second = 0; second < duration * 60; second++)
+    {
+        uint32_t minute = second / 60;
+        if (minute / 5 != servedSlot)
+        {
+            servedSlot = minute / 5;
+            HostHTTPServer::SetResponse(200, BuildShowerRainText(minute, onset, end));
+        }
+        uint32_t requests = HostHTTPServer::GetRequestCount();
+        rain.Process();
+        if (HostHTTPServer::GetRequestCount() != requests)
+        {
+            lastPollMinute = minute;
+        }
+        if (firstWarning < 0 && rain.GetForecast().GetMinutesToRain() != RAINFORECAST_NONE)
+        {
+            firstWarning = (int32_t)minute;
+        }
+        if (second == onset * 60)
+        {
+            pollAgeAtOnset = minute - lastPollMinute;
+        }
+        HostHal::AdvanceMillis(1000);
+    }
+    printf("%-44s %12u polls, rain seen %d min ahead, last poll %u min before onset\n", "Forecast driven schedule, 6 h, 1 shower", HostHTTPServer::GetRequestCount(),
+        firstWarning < 0 ? -1 : (int)(onset - firstWarning), pollAgeAtOnset);
+
+    //The fixed schedule it replaces: 5 minutes with rain in the first 5 lines, else 15 minutes
+    uint32_t fixedPolls = 0;
+    for (uint32_t minute = 0; minute < duration; fixedPolls++)
+    {
+        bool isRainSoon = minute + 25 > onset && minute < end;
+        minute += isRainSoon ? 5 : 15;
+    }
+    printf("%-44s %12u polls\n", "Fixed 5/15 minute schedule, 6 h, 1 shower", fixedPolls);
+}
+
+static void BenchBuienradarConnection()
+{
+    BenchUtil::PrintHeader("Buienradar connection, 24 polls");
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    HostHTTPServer::SetResponse(200, BuildRainText(6));
+    BuienradarHTTPClient client;
+    unsigned long handshakeMs = 0;
+    uint32_t clientPeak = 0;
+    int64_t heapBase = BenchUtil::GetHeapCounters().inUse;
+    BenchUtil::ResetHeapPeak();
+    for (uint8_t poll = 0; poll < 24; poll++)
+    {
+        client.HTTPRequestAsync("gpsgadget.buienradar.nl", 443, "/data/raintext/?lat=52.22&lon=4.53");
+        for (int i = 0; i < 1000 && client.GetAsyncStatus() == HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_PENDING; i++)
+        {
+            client.ProcessAsync();
+        }
+        if (client.GetAsyncStatus() != HTTPREQUEST_STATUS::HTTPREQUEST_STATUS_SUCCESS || client.GetRainText().GetSampleCount() != 24)
+        {
+            printf("Buienradar connection: poll %u failed\n", poll);
+        }
+        handshakeMs += client.GetLastHandshakeMillis();
+        clientPeak = client.GetPollHeapPeak() > clientPeak ? client.GetPollHeapPeak() : clientPeak;
+        client.ReleaseAsync();
+        HostHal::AdvanceMillis(5 * 60000UL);
+    }
+    //The sampled peak misses the handshake buffers, they are freed inside Connect()
+    printf("%-44s %2u handshakes, %6.0f ms connect/poll, peak heap %lld (sampled %u)\n", "Full TLS handshake, poll every 5 min",
+        HostHTTPServer::GetHandshakeCount(), (double)handshakeMs / 24.0, (long long)(BenchUtil::GetHeapCounters().peak - heapBase), clientPeak);
+}
+
+static void BenchBuienradarConditional()
+{
+    //Three hours of rain, the server regenerates the forecast every 10 minutes
+    const char* names[] = { "No cache headers", "ETag", "ETag and max-age" };
+    BenchUtil::PrintHeader("Buienradar conditional GET, 3 h of rain");
+    for (uint8_t variant = 0; variant < 3; variant++)
+    {
+        HostHal::Reset();
+        HostHTTPServer::Reset();
+        Buienradar rain(String("52.22"), String("4.53"));
+        rain.SetOnRainReportEvent(OnRain);
+        for (uint32_t second = 0; second < 3 * 3600; second++)
+        {
+            uint32_t generation = second / 600;
+            HostHTTPServer::SetResponse(200, BuildShowerRainText(generation * 10, 0, 24 * 60));
+            char value[32];
+            if (variant >= 1)
+            {
+                snprintf(value, sizeof(value), "\"%u\"", generation);
+                HostHTTPServer::AddResponseHeader("ETag", value);
+            }
+            if (variant >= 2)
+            {
+                snprintf(value, sizeof(value), "max-age=%u", (generation + 1) * 600 - second);
+                HostHTTPServer::AddResponseHeader("Cache-Control", value);
+            }
+            rain.Process();
+            HostHal::AdvanceMillis(1000);
+        }
+        if (!rain.GetLastRequestSucceeded() || rain.GetForecast().GetMinutesToRain() != 0)
+        {
+            printf("Buienradar conditional GET: forecast lost\n");
+        }
+        printf("%-44s %12u requests, %u not modified, %u payload bytes\n", names[variant], HostHTTPServer::GetRequestCount(),
+            HostHTTPServer::GetNotModifiedCount(), HostHTTPServer::GetPayloadBytes());
+    }
+}
+
+static void BenchRetryPolicy()
+{
+    BenchUtil::PrintHeader("Buienradar retry policy, 6 h outage");
+    //Backoff without jitter doubles to the cap, the circuit opens at the threshold and a failed trial opens it again
+    RetryPolicy policy(1000, 8000, 0, 6, 60000);
+    const unsigned long expected[] = { 1000, 2000, 4000, 8000, 8000, 60000, 60000 };
+    for (uint8_t i = 0; i < 7; i++)
+    {
+        policy.OnAttempt();
+        if (policy.OnFailure() != expected[i])
+        {
+            printf("RetryPolicy: unexpected delay %lu after %u failures\n", policy.GetLastDelay(), i + 1);
+        }
+    }
+    policy.OnAttempt();
+    if (policy.GetState() != RETRYPOLICY_STATE::RETRYPOLICY_STATE_HALF_OPEN || policy.GetOpenCount() != 2)
+    {
+        printf("RetryPolicy: unexpected state %s\n", policy.ToString().c_str());
+    }
+    policy.OnSuccess();
+    if (policy.GetState() != RETRYPOLICY_STATE::RETRYPOLICY_STATE_CLOSED || policy.OnFailure() != 1000)
+    {
+        printf("RetryPolicy: not closed after a success %s\n", policy.ToString().c_str());
+    }
+
+    //A 200 that is not raintext, like a captive portal page, is a failure and keeps the last forecast
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    HostHTTPServer::SetResponse(200, BuildRainText(6));
+    Buienradar portal(String("52.22"), String("4.53"));
+    portal.SetOnRainReportEvent(OnRain);
+    for (int i = 0; i < 100 && portal.GetForecast().GetHorizonMinutes() == 0; i++)
+    {
+        portal.Process();
+        HostHal::AdvanceMillis(1000);
+    }
+    HostHTTPServer::SetResponse(200, "<html><body>Log in to continue</body></html>");
+    HostHal::AdvanceMillis(portal.GetWaitTime() * 1000 + 1);
+    for (int i = 0; i < 100 && portal.GetRetryPolicy().GetConsecutiveFailures() == 0; i++)
+    {
+        portal.Process();
+    }
+    if (portal.GetLastRequestSucceeded() || portal.GetRetryPolicy().GetConsecutiveFailures() != 1 || portal.GetForecast().GetHorizonMinutes() == 0)
+    {
+        printf("Buienradar: unexpected result for an HTML response %s\n", portal.GetRetryPolicy().ToString().c_str());
+    }
+
+    //Two stations with differently seeded jitter, the server is unreachable from 0:10 to 6:10
+    for (uint8_t station = 0; station < 2; station++)
+    {
+        HostHal::Reset();
+        HostHTTPServer::Reset();
+        HostHTTPServer::SetResponse(200, BuildRainText(0));
+        Buienradar rain(String("52.22"), String("4.53"));
+        rain.SetOnRainReportEvent(OnRain);
+        rain.GetRetryPolicy().Seed(station + 1);
+        uint32_t outageConnects = 0;
+        uint32_t recoverySeconds = 0;
+        for (uint32_t second = 0; second < 8 * 3600; second++)
+        {
+            bool isOutage = second >= 600 && second < 600 + 6 * 3600;
+            HostHTTPServer::SetConnectFailure(isOutage);
+            uint32_t connects = HostHTTPServer::GetConnectCount();
+            rain.Process();
+            if (isOutage)
+            {
+                outageConnects += HostHTTPServer::GetConnectCount() - connects;
+            }
+            else if (second > 600 && recoverySeconds == 0 && HostHTTPServer::GetConnectCount() != connects)
+            {
+                recoverySeconds = second - (600 + 6 * 3600);
+            }
+            HostHal::AdvanceMillis(1000);
+        }
+        char name[64];
+        snprintf(name, sizeof(name), "Backoff and circuit breaker, seed %u", station + 1);
+        printf("%-44s %12u attempts, circuit opened %u times, first poll %u s after recovery\n", name, outageConnects, rain.GetRetryPolicy().GetOpenCount(), recoverySeconds);
+    }
+    printf("%-44s %12u attempts\n", "Fixed 30 s retry", 6 * 3600 / 30);
+}
+
+static void BenchDnsCache()
+{
+    HostHal::Reset();
+    HostHTTPServer::Reset();
+    HostDns::SetAddress("gpsgadget.buienradar.nl", IPAddress(10, 0, 0, 7));
+    DnsCache cache;
+    cache.Configure(60000, 600000);
+    IPAddress address;
+    //Miss, hit, literal, expiry, stale-if-error within its window, failure after it
+    bool isCorrect = cache.Resolve("gpsgadget.buienradar.nl", address) && address == IPAddress(10, 0, 0, 7);
+    isCorrect = isCorrect && cache.Resolve("gpsgadget.buienradar.nl", address) && cache.GetHitCount() == 1 && cache.GetMissCount() == 1;
+    isCorrect = isCorrect && cache.Resolve("192.168.1.20", address) && address == IPAddress(192, 168, 1, 20) && cache.GetMissCount() == 1;
+    HostHal::AdvanceMillis(60000);
+    isCorrect = isCorrect && cache.Resolve("gpsgadget.buienradar.nl", address) && cache.GetMissCount() == 2;
+    HostDns::SetFailure(true);
+    cache.Expire("gpsgadget.buienradar.nl");
+    isCorrect = isCorrect && cache.Resolve("gpsgadget.buienradar.nl", address) && address == IPAddress(10, 0, 0, 7) && cache.GetStaleCount() == 1;
+    HostHal::AdvanceMillis(660000);
+    isCorrect = isCorrect && !cache.Resolve("gpsgadget.buienradar.nl", address) && cache.GetFailureCount() == 1;
+    if (!isCorrect || HostDns::GetLookupCount() != 4)
+    {
+        printf("DnsCache: unexpected %s\n", cache.ToString().c_str());
+    }
+
+    //12 hours of SysAP reconnects every 10 minutes, the resolver is down from 3:00 to 6:00. Buienradar connects by name,
+    //its TLS server name has to be the host name.
+    BenchUtil::PrintHeader("SysAP name resolution, 12 h, resolver down 3 h");
+    for (uint8_t withCache = 0; withCache < 2; withCache++)
+    {
+        HostHal::Reset();
+        HostDns::SetAddress("sysap.local", IPAddress(192, 168, 1, 20));
+        uint32_t lookupsBefore = HostDns::GetLookupCount();
+        DnsCache dnsCache;
+        uint32_t unresolved = 0;
+        for (uint32_t minute = 0; minute < 12 * 60; minute += 10)
+        {
+            HostDns::SetFailure(minute >= 3 * 60 && minute < 6 * 60);
+            IPAddress address;
+            bool isResolved = withCache ? dnsCache.Resolve("sysap.local", address) : WiFi.hostByName("sysap.local", address) == 1;
+            if (!isResolved || address != IPAddress(192, 168, 1, 20))
+            {
+                unresolved++;
+            }
+            HostHal::AdvanceMillis(600000);
+        }
+        HostDns::SetFailure(false);
+        printf("%-44s %12u lookups, %u reconnects without an address\n", withCache ? "DNS cache, stale-if-error" : "WiFi.hostByName",
+            HostDns::GetLookupCount() - lookupsBefore, unresolved);
+        if (withCache)
+        {
+            printf("%-44s %s\n", "", dnsCache.ToString().c_str());
+        }
+    }
+}
+
+int main()
+{
+    BenchWindSpeed();
+    BenchWindStatistics();
+    BenchWindDistribution();
+    BenchWindPulseCounters();
+    BenchWindDebounce();
+    BenchWindCounterFallback();
+    BenchInstantWindSpeed();
+    BenchBrightness();
+    BenchReportPolicy();
+    BenchDerivedWeather();
+    BenchTemperature();
+    BenchTemperatureProfiles();
+    BenchOneWireTransport();
+    BenchBuienradar();
+    BenchRainForecast();
+    BenchBuienradarConnection();
+    BenchBuienradarConditional();
+    BenchRetryPolicy();
+    BenchDnsCache();
+    return (int)(benchSink * 0);
+}
@@ -0,0 +1,334 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// SensorReplay.cpp
+// Replays a recorded sensor trace through WindSpeed, BrightnessSensor and TemperatureSensor (and with -d the
+// DerivedWeather quantities) on the virtual clock and writes every callback with its virtual timestamp.
+//
+// Trace format, one record per line, sorted on time, '#' starts a comment:
+//   <time_ms>,pulses,<count>   anemometer pulses counted since the previous pulses record
+//   <time_ms>,adc,<raw>        light sensor ADC reading, valid from time_ms on
+//   <time_ms>,temp,<celsius>   DS18B20 temperature, valid from time_ms on
+// The pulses of a record are spread evenly over the time since the previous pulses record.
+//
+// Output: <time_ms>,<callback>,<value> on stdout (or the file given with -o), a summary on stderr.
+
+#include "arduino.h"
+#include "WindSpeed.h"
+#include "BrightnessSensor.h"
+#include "TemperatureSensor.h"
+#include "DerivedWeather.h"
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+#define REPLAY_PIN_WINDSPEED 34
+#define REPLAY_PIN_ONEWIRE 27
+#define REPLAY_PIN_LIGHT A0
+#define REPLAY_DEFAULT_STEP_MS 10 //Process() cadence of the virtual loop
+
+enum REPLAY_CHANNEL :uint8_t
+{
+    REPLAY_CHANNEL_NONE = 0,
+    REPLAY_CHANNEL_PULSES = 1,
+    REPLAY_CHANNEL_ADC = 2,
+    REPLAY_CHANNEL_TEMP = 3,
+};
+
+struct ReplayRecord
+{
+    uint64_t timeMs;
+    REPLAY_CHANNEL channel;
+    double value;
+};
+
+static FILE* replayOut = NULL;
+static uint64_t callbackCount = 0;
+static DerivedWeather* replayDerived = NULL; //With -d, fed by the callbacks like on the station
+
+static void Emit(const char* callback, const double& value)
+{
+    fprintf(replayOut, "%llu,%s,%g\n", (unsigned long long)millis(), callback, value);
+    callbackCount++;
+}
+
+static void OnWindGust(const float& maxWindGust) { Emit("WINDGUST_CHANGED", maxWindGust); }
+static void OnWindMean(const float& meanWind)
+{
+    Emit("WINDMEAN_CHANGED", meanWind);
+    if (replayDerived != NULL)
+    {
+        replayDerived->SetWindSpeed(meanWind);
+    }
+}
+static void OnWindBeaufort(const uint8_t& beaufortSpeed) { Emit("WINDBEAUFORT_CHANGED", beaufortSpeed); }
+static void OnBrightness(const uint16_t& luxValue) { Emit("BRIGHTNESS_CHANGED", luxValue); }
+static void OnTemperature(const float& temperature)
+{
+    Emit("TEMPERATURE_CHANGED", temperature);
+    if (replayDerived != NULL)
+    {
+        replayDerived->SetTemperature(temperature);
+    }
+}
+static void OnDerived(const DERIVEDWEATHER_QUANTITY& quantity, const float& value)
+{
+    Emit(quantity == DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_WINDCHILL ? "WINDCHILL_CHANGED" :
+        quantity == DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE ? "FEELSLIKE_CHANGED" :
+        quantity == DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_DEWPOINT ? "DEWPOINT_CHANGED" : "HEATINDEX_CHANGED", value);
+}
+
+static bool ReadRecord(FILE* trace, ReplayRecord& record, uint64_t& lineNumber)
+{
+    char line[256];
+    while (fgets(line, sizeof(line), trace) != NULL)
+    {
+        lineNumber++;
+        char* comment = strchr(line, '#');
+        if (comment != NULL)
+        {
+            *comment = 0;
+        }
+        unsigned long long timeMs;
+        char channel[16];
+        double value;
+        if (sscanf(line, " %llu , %15[a-z] , %lf", &timeMs, channel, &value) != 3)
+        {
+            if (strspn(line, " \t\r\n") != strlen(line))
+            {
+                fprintf(stderr, "line %llu: invalid record\n", (unsigned long long)lineNumber);
+            }
+            continue;
+        }
+        record.timeMs = timeMs;
+        record.value = value;
+        if (strcmp(channel, "pulses") == 0)
+            record.channel = REPLAY_CHANNEL_PULSES;
+        else if (strcmp(channel, "adc") == 0)
+            record.channel = REPLAY_CHANNEL_ADC;
+        else if (strcmp(channel, "temp") == 0)
+            record.channel = REPLAY_CHANNEL_TEMP;
+        else
+        {
+            fprintf(stderr, "line %llu: unknown channel %s\n", (unsigned long long)lineNumber, channel);
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
+
+static uint64_t RecordApplyMs(const ReplayRecord& record, const uint64_t& lastPulseRecordMs)
+{
+    if (record.channel == REPLAY_CHANNEL_PULSES)
+    {
+        return (lastPulseRecordMs < record.timeMs) ? lastPulseRecordMs : record.timeMs;
+    }
+    return record.timeMs;
+}
+
+static uint64_t NextPulseUs(const uint64_t& windowStartUs, const uint64_t& windowUs, const uint64_t& total, const uint64_t& fired)
+{
+    return windowStartUs + ((fired + 1) * windowUs) / total;
+}
+
+static void FirePulses(const uint64_t& windowStartUs, const uint64_t& windowUs, const uint64_t& total, uint64_t& fired)
+{
+    //Pulses that fell due while the clock jumped (a blocking sensor read) are fired at their own time,
+    //as the interrupt would have done during the blocking call
+    uint64_t nowUs = HostHal::GetMicros();
+    while (fired < total && NextPulseUs(windowStartUs, windowUs, total, fired) <= nowUs)
+    {
+        HostHal::SetMicros(NextPulseUs(windowStartUs, windowUs, total, fired));
+        HostHal::PulsePin(REPLAY_PIN_WINDSPEED);
+        fired++;
+    }
+    HostHal::SetMicros(nowUs);
+}
+
+static void Usage()
+{
+    fprintf(stderr, "usage: sensor_replay [-s step_ms] [-a] [-p] [-d] [-o output.csv] trace.csv\n");
+    fprintf(stderr, "  -a  adaptive wind cadence\n");
+    fprintf(stderr, "  -p  report policies of the station (deadband, hysteresis, report intervals)\n");
+    fprintf(stderr, "  -d  derived quantities (wind chill, feels-like) from the temperature and mean wind callbacks\n");
+}
+
+int main(int argc, char** argv)
+{
+    const char* tracePath = NULL;
+    const char* outPath = NULL;
+    uint64_t stepMs = REPLAY_DEFAULT_STEP_MS;
+    bool adaptiveCadence = false;
+    bool reportPolicies = false;
+    bool derivedQuantities = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            stepMs = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "-a") == 0)
+            adaptiveCadence = true;
+        else if (strcmp(argv[i], "-p") == 0)
+            reportPolicies = true;
+        else if (strcmp(argv[i], "-d") == 0)
+            derivedQuantities = true;
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            outPath = argv[++i];
+        else if (argv[i][0] != '-' && tracePath == NULL)
+            tracePath = argv[i];
+        else
+        {
+            Usage();
+            return 2;
+        }
+    }
+    if (tracePath == NULL || stepMs == 0)
+    {
+        Usage();
+        return 2;
+    }
+
+    FILE* trace = fopen(tracePath, "r");
+    if (trace == NULL)
+    {
+        perror(tracePath);
+        return 1;
+    }
+    replayOut = (outPath != NULL) ? fopen(outPath, "w") : stdout;
+    if (replayOut == NULL)
+    {
+        perror(outPath);
+        fclose(trace);
+        return 1;
+    }
+
+    ReplayRecord record;
+    uint64_t lineNumber = 0;
+    bool hasRecord = ReadRecord(trace, record, lineNumber);
+
+    //The station boots at the first record of the trace
+    HostHal::Reset();
+    HostHal::SetMicros(hasRecord ? record.timeMs * 1000 : 0);
+    WindSpeed wind(REPLAY_PIN_WINDSPEED);
+    wind.SetOnWindGustsChangeEvent(OnWindGust);
+    wind.SetOnWindBeaufortChangeEvent(OnWindBeaufort);
+    wind.SetOnWindMeanChangeEvent(OnWindMean);
+    wind.SetAdaptiveCadence(adaptiveCadence);
+    BrightnessSensor brightness(REPLAY_PIN_LIGHT);
+    brightness.SetOnLuxValueChangeEvent(OnBrightness);
+    TemperatureSensor temperature(REPLAY_PIN_ONEWIRE);
+    temperature.SetOnTemperatureChangeEvent(OnTemperature);
+    DerivedWeather derived;
+    derived.SetOnDerivedValueChangeEvent(OnDerived);
+    replayDerived = derivedQuantities ? &derived : NULL;
+    if (reportPolicies)
+    {
+        wind.GetGustReportPolicy().Configure(WINDSPEED_GUST_REPORT_POLICY);
+        wind.GetMeanReportPolicy().Configure(WINDSPEED_MEAN_REPORT_POLICY);
+        wind.GetBeaufortReportPolicy().Configure(WINDSPEED_BEAUFORT_REPORT_POLICY);
+        brightness.GetReportPolicy().Configure(BRIGHTNESS_REPORT_POLICY);
+        temperature.GetReportPolicy().Configure(TEMPERATURE_REPORT_POLICY);
+        for (uint8_t q = 0; q < DERIVEDWEATHER_QUANTITY_COUNT; q++)
+        {
+            derived.GetReportPolicy((DERIVEDWEATHER_QUANTITY)q).Configure(DERIVEDWEATHER_REPORT_POLICY);
+        }
+    }
+
+    fprintf(replayOut, "time_ms,callback,value\n");
+    uint64_t replayStartUs = HostHal::GetMicros();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    //Pulses of the current pulses record, fired at evenly spaced virtual times
+    uint64_t pulseWindowStartUs = 0;
+    uint64_t pulseWindowUs = 0;
+    uint64_t pulsesTotal = 0;
+    uint64_t pulsesFired = 0;
+    uint64_t lastPulseRecordMs = millis();
+    uint64_t nextStepUs = HostHal::GetMicros();
+
+    while (hasRecord || pulsesFired < pulsesTotal)
+    {
+        FirePulses(pulseWindowStartUs, pulseWindowUs, pulsesTotal, pulsesFired);
+
+        //A pulses record is applied at the start of its window, the other channels at their timestamp
+        while (hasRecord && RecordApplyMs(record, lastPulseRecordMs) * 1000 <= HostHal::GetMicros())
+        {
+            switch (record.channel)
+            {
+            case REPLAY_CHANNEL_PULSES:
+                FirePulses(pulseWindowStartUs, pulseWindowUs, pulsesTotal, pulsesFired);
+                pulseWindowStartUs = lastPulseRecordMs * 1000;
+                pulseWindowUs = (record.timeMs - lastPulseRecordMs) * 1000;
+                pulsesTotal = (uint64_t)record.value;
+                pulsesFired = 0;
+                lastPulseRecordMs = record.timeMs;
+                break;
+            case REPLAY_CHANNEL_ADC:
+                HostHal::SetAnalogValue(REPLAY_PIN_LIGHT, (uint16_t)record.value);
+                break;
+            case REPLAY_CHANNEL_TEMP:
+                HostHal::SetProbeTemperature((float)record.value);
+                break;
+            default:
+                break;
+            }
+            hasRecord = ReadRecord(trace, record, lineNumber);
+        }
+
+        FirePulses(pulseWindowStartUs, pulseWindowUs, pulsesTotal, pulsesFired);
+
+        if (HostHal::GetMicros() >= nextStepUs)
+        {
+            wind.Process();
+            temperature.Process();
+            brightness.Process();
+            if (replayDerived != NULL)
+            {
+                replayDerived->Process();
+            }
+            nextStepUs += stepMs * 1000;
+        }
+
+        //Jump to the next moment something happens: a loop step, a pulse or a record
+        uint64_t nextUs = nextStepUs;
+        if (pulsesFired < pulsesTotal)
+        {
+            nextUs = std::min(nextUs, NextPulseUs(pulseWindowStartUs, pulseWindowUs, pulsesTotal, pulsesFired));
+        }
+        if (hasRecord)
+        {
+            nextUs = std::min(nextUs, RecordApplyMs(record, lastPulseRecordMs) * 1000);
+        }
+        if (nextUs > HostHal::GetMicros())
+        {
+            HostHal::SetMicros(nextUs);
+        }
+    }
+
+    double wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double virtualSeconds = (double)(HostHal::GetMicros() - replayStartUs) / 1e6;
+    fprintf(stderr, "replayed %.0f s (%.2f days) in %.3f s wall, %.0fx real time, %llu callbacks\n",
+        virtualSeconds, virtualSeconds / 86400.0, wallSeconds, wallSeconds > 0 ? virtualSeconds / wallSeconds : 0.0, (unsigned long long)callbackCount);
+    if (replayDerived != NULL)
+    {
+        fprintf(stderr, "derived: wind chill computed %u times, feels-like %u times\n",
+            derived.GetComputeCount(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_WINDCHILL), derived.GetComputeCount(DERIVEDWEATHER_QUANTITY::DERIVEDWEATHER_QUANTITY_FEELSLIKE));
+    }
+
+    fclose(trace);
+    if (replayOut != stdout)
+    {
+        fclose(replayOut);
+    }
+    return 0;
+}
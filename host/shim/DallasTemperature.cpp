@@ -0,0 +1,183 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "DallasTemperature.h"
+
+void DallasTemperature::begin()
+{
+    //Enumerate the bus, the resolution is the highest of the probes
+    DeviceAddress deviceAddress;
+    ScratchPad scratchPad;
+    devices = 0;
+    bus->reset_search();
+    while (bus->search(deviceAddress))
+    {
+        if (validAddress(deviceAddress))
+        {
+            devices++;
+            if (readScratchPad(deviceAddress, scratchPad))
+            {
+                uint8_t resolution = ((scratchPad[4] >> 5) & 0x03) + 9;
+                bitResolution = resolution > bitResolution ? resolution : bitResolution;
+            }
+        }
+    }
+}
+
+bool DallasTemperature::validAddress(const uint8_t* deviceAddress)
+{
+    return OneWire::crc8(deviceAddress, 7) == deviceAddress[7];
+}
+
+bool DallasTemperature::getAddress(uint8_t* deviceAddress, uint8_t index)
+{
+    //Searches from the start of the bus up to the device
+    uint8_t depth = 0;
+    bus->reset_search();
+    while (depth <= index && bus->search(deviceAddress))
+    {
+        if (depth == index && validAddress(deviceAddress))
+        {
+            return true;
+        }
+        depth++;
+    }
+    return false;
+}
+
+bool DallasTemperature::readScratchPad(const uint8_t* deviceAddress, uint8_t* scratchPad)
+{
+    if (bus->reset() == 0)
+    {
+        return false;
+    }
+    bus->select(deviceAddress);
+    bus->write(0xBE);
+    bus->read_bytes(scratchPad, 9);
+    return bus->reset() == 1;
+}
+
+bool DallasTemperature::isConnected(const uint8_t* deviceAddress, uint8_t* scratchPad)
+{
+    if (!readScratchPad(deviceAddress, scratchPad))
+    {
+        return false;
+    }
+    bool allZeros = true;
+    for (uint8_t i = 0; i < 9; i++)
+    {
+        allZeros = allZeros && scratchPad[i] == 0;
+    }
+    return !allZeros && OneWire::crc8(scratchPad, 8) == scratchPad[8];
+}
+
+bool DallasTemperature::setResolution(uint8_t newResolution)
+{
+    if (newResolution < 9 || newResolution > 12)
+    {
+        return false;
+    }
+    bitResolution = newResolution;
+    DeviceAddress deviceAddress;
+    ScratchPad scratchPad;
+    bus->reset_search();
+    while (bus->search(deviceAddress))
+    {
+        if (!validAddress(deviceAddress) || !isConnected(deviceAddress, scratchPad))
+        {
+            continue;
+        }
+        //TH, TL and the configuration register
+        bus->reset();
+        bus->select(deviceAddress);
+        bus->write(0x4E);
+        bus->write(scratchPad[2]);
+        bus->write(scratchPad[3]);
+        bus->write((uint8_t)(((newResolution - 9) << 5) | 0x1F));
+        bus->reset();
+    }
+    return true;
+}
+
+bool DallasTemperature::setResolution(const uint8_t* deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation)
+{
+    ScratchPad scratchPad;
+    if (newResolution < 9 || newResolution > 12 || !isConnected(deviceAddress, scratchPad))
+    {
+        return false;
+    }
+    bus->reset();
+    bus->select(deviceAddress);
+    bus->write(0x4E);
+    bus->write(scratchPad[2]);
+    bus->write(scratchPad[3]);
+    bus->write((uint8_t)(((newResolution - 9) << 5) | 0x1F));
+    bus->reset();
+    if (!skipGlobalBitResolutionCalculation)
+    {
+        begin();
+    }
+    return true;
+}
+
+int16_t DallasTemperature::millisToWaitForConversion(uint8_t bitResolution)
+{
+    switch (bitResolution)
+    {
+    case 9:
+        return 94;
+    case 10:
+        return 188;
+    case 11:
+        return 375;
+    default:
+        return 750;
+    }
+}
+
+void DallasTemperature::requestTemperatures()
+{
+    //Skip ROM, all probes convert at once
+    bus->reset();
+    bus->skip();
+    bus->write(0x44);
+    if (waitForConversion)
+    {
+        delay(millisToWaitForConversion(bitResolution));
+    }
+}
+
+bool DallasTemperature::isConversionComplete()
+{
+    return bus->read_bit() == 1;
+}
+
+float DallasTemperature::getTempCByIndex(uint8_t index)
+{
+    DeviceAddress deviceAddress;
+    if (!getAddress(deviceAddress, index))
+    {
+        return DEVICE_DISCONNECTED_C;
+    }
+    return getTempC(deviceAddress);
+}
+
+float DallasTemperature::getTempC(const uint8_t* deviceAddress)
+{
+    ScratchPad scratchPad;
+    if (!isConnected(deviceAddress, scratchPad))
+    {
+        return DEVICE_DISCONNECTED_C;
+    }
+    int16_t raw = (int16_t)(((uint16_t)scratchPad[1] << 8) | scratchPad[0]);
+    return (float)raw * 0.0625f;
+}
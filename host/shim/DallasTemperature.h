@@ -0,0 +1,52 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// DallasTemperature.h
+// Host stand-in for the DallasTemperature library, on top of the OneWire shim. A DS18B20 is simulated on the
+// bus for every connected HostHal probe (see HostOneWire.h), its temperature comes from HostHal::SetProbeTemperature.
+// Conversions take their datasheet time on the virtual clock, so blocking calls show up as loop latency in the host benchmarks.
+
+#pragma once
+#include "arduino.h"
+#include "OneWire.h"
+
+#define DEVICE_DISCONNECTED_C -127
+
+typedef uint8_t DeviceAddress[8];
+typedef uint8_t ScratchPad[9];
+
+class DallasTemperature
+{
+public:
+	DallasTemperature(OneWire* bus) : bus(bus) {}
+	void begin();
+	uint8_t getDeviceCount() { return devices; }
+	bool validAddress(const uint8_t* deviceAddress);
+	bool getAddress(uint8_t* deviceAddress, uint8_t index);
+	bool readScratchPad(const uint8_t* deviceAddress, uint8_t* scratchPad);
+	bool isConnected(const uint8_t* deviceAddress, uint8_t* scratchPad);
+	bool setResolution(uint8_t newResolution);
+	bool setResolution(const uint8_t* deviceAddress, uint8_t newResolution, bool skipGlobalBitResolutionCalculation = false);
+	uint8_t getResolution() { return bitResolution; }
+	void setWaitForConversion(bool flag) { waitForConversion = flag; }
+	bool getWaitForConversion() { return waitForConversion; }
+	void requestTemperatures();
+	bool isConversionComplete();
+	float getTempCByIndex(uint8_t index);
+	float getTempC(const uint8_t* deviceAddress);
+	int16_t millisToWaitForConversion(uint8_t bitResolution);
+private:
+	OneWire* bus;
+	uint8_t devices = 0;
+	uint8_t bitResolution = 9;
+	bool waitForConversion = true;
+};
@@ -0,0 +1,266 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "HTTPClient.h"
+
+uint16_t HostHTTPServer::status = 200;
+String HostHTTPServer::body;
+std::vector<String> HostHTTPServer::headerKeys;
+std::vector<String> HostHTTPServer::headerValues;
+bool HostHTTPServer::connectFailure = false;
+bool HostHTTPServer::sendContentLength = true;
+uint32_t HostHTTPServer::connectCount = 0;
+uint32_t HostHTTPServer::requestCount = 0;
+uint32_t HostHTTPServer::handshakeCount = 0;
+uint32_t HostHTTPServer::notModifiedCount = 0;
+uint32_t HostHTTPServer::payloadBytes = 0;
+
+void HostHTTPServer::SetResponse(const uint16_t& status, const String& body)
+{
+    HostHTTPServer::status = status;
+    HostHTTPServer::body = body;
+    headerKeys.clear();
+    headerValues.clear();
+}
+
+void HostHTTPServer::AddResponseHeader(const String& key, const String& value)
+{
+    headerKeys.push_back(key);
+    headerValues.push_back(value);
+}
+
+void HostHTTPServer::Reset()
+{
+    SetResponse(200, "");
+    connectFailure = false;
+    sendContentLength = true;
+    connectCount = 0;
+    requestCount = 0;
+    handshakeCount = 0;
+    notModifiedCount = 0;
+    payloadBytes = 0;
+    HostDns::Reset();
+}
+
+String HostHTTPServer::GetResponseHeader(const String& key)
+{
+    for (size_t i = 0; i < headerKeys.size(); i++)
+    {
+        if (headerKeys[i].equalsIgnoreCase(key))
+        {
+            return headerValues[i];
+        }
+    }
+    return "";
+}
+
+bool HostHTTPServer::IsNotModified(const String& ifNoneMatch, const String& ifModifiedSince)
+{
+    //If-None-Match takes precedence, the dates are compared as text, the server sends the same representation
+    if (ifNoneMatch.length() > 0)
+    {
+        String eTag = GetResponseHeader("ETag");
+        return eTag.length() > 0 && eTag == ifNoneMatch;
+    }
+    if (ifModifiedSince.length() > 0)
+    {
+        String lastModified = GetResponseHeader("Last-Modified");
+        return lastModified.length() > 0 && lastModified == ifModifiedSince;
+    }
+    return false;
+}
+
+bool HTTPClient::Connect(const char* host, const uint16_t& port)
+{
+    IPAddress address;
+    if (!WiFi.hostByName(host, address))
+    {
+        sessionStartMillis = millis();
+        state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_FAILED;
+        return false;
+    }
+    (void)port;
+    CloseConnection();
+    sessionStartMillis = millis();
+    HostHTTPServer::connectCount++;
+    if (HostHTTPServer::connectFailure)
+    {
+        state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_FAILED;
+        return false;
+    }
+    if (useTLS)
+    {
+        HostHTTPServer::handshakeCount++;
+        connectionBuffer = new uint8_t[HOST_TLS_CONNECTION_HEAP];
+        handshakeBuffer = new uint8_t[HOST_TLS_HANDSHAKE_HEAP];
+        HostHal::AdvanceMillis(HOST_TLS_FULL_HANDSHAKE_MS);
+        delete[] handshakeBuffer;
+        handshakeBuffer = NULL;
+    }
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_CONNECTED;
+    return true;
+}
+
+void HTTPClient::CloseConnection()
+{
+    if (connectionBuffer != NULL)
+    {
+        delete[] connectionBuffer;
+        connectionBuffer = NULL;
+    }
+}
+
+void HTTPClient::AddRequestHeader(const String& key, const String& value)
+{
+    if (key.equalsIgnoreCase("If-None-Match"))
+    {
+        ifNoneMatch = value;
+    }
+    else if (key.equalsIgnoreCase("If-Modified-Since"))
+    {
+        ifModifiedSince = value;
+    }
+}
+
+bool HTTPClient::Request(const String& method, const String& uri, const String& data)
+{
+    (void)method;
+    (void)uri;
+    (void)data;
+    if (state != HTTPCLIENT_STATE::HTTPCLIENT_STATE_CONNECTED)
+    {
+        return false;
+    }
+    isNotModified = HostHTTPServer::status == 200 && HostHTTPServer::IsNotModified(ifNoneMatch, ifModifiedSince);
+    ifNoneMatch = "";
+    ifModifiedSince = "";
+    if (isNotModified)
+    {
+        HostHTTPServer::notModifiedCount++;
+    }
+    HostHTTPServer::requestCount++;
+    headerIndex = 0;
+    payloadIndex = 0;
+    payload = "";
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_REQUESTED;
+    return true;
+}
+
+bool HTTPClient::ReadResult(uint16_t* resultCode)
+{
+    if (state != HTTPCLIENT_STATE::HTTPCLIENT_STATE_REQUESTED)
+    {
+        *resultCode = 0xFFFF;
+        return false;
+    }
+    *resultCode = isNotModified ? 304 : HostHTTPServer::status;
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_HEADERS;
+    return true;
+}
+
+bool HTTPClient::ReadHeaders(String& key, String& value)
+{
+    if (state != HTTPCLIENT_STATE::HTTPCLIENT_STATE_HEADERS)
+    {
+        return false;
+    }
+    size_t scripted = HostHTTPServer::headerKeys.size();
+    if (headerIndex < scripted)
+    {
+        key = HostHTTPServer::headerKeys[headerIndex];
+        value = HostHTTPServer::headerValues[headerIndex];
+        headerIndex++;
+        return true;
+    }
+    //Followed by the headers of the server itself
+    if (headerIndex == scripted)
+    {
+        headerIndex++;
+        if (HostHTTPServer::sendContentLength)
+        {
+            key = "Content-Length";
+            value = String(GetResponseLength());
+            return true;
+        }
+    }
+    if (headerIndex == scripted + 1)
+    {
+        key = "Connection";
+        value = "close";
+        headerIndex++;
+        return true;
+    }
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_DATA;
+    return false;
+}
+
+bool HTTPClient::ReadPayload()
+{
+    if (state != HTTPCLIENT_STATE::HTTPCLIENT_STATE_DATA)
+    {
+        return false;
+    }
+    unsigned int remaining = GetResponseLength() - payloadIndex;
+    unsigned int chunk = remaining < HOST_HTTP_PAYLOAD_CHUNK ? remaining : HOST_HTTP_PAYLOAD_CHUNK;
+    payload += HostHTTPServer::body.substring(payloadIndex, payloadIndex + chunk);
+    payloadIndex += chunk;
+    HostHTTPServer::payloadBytes += chunk;
+    if (payloadIndex >= GetResponseLength())
+    {
+        CompleteResponse();
+    }
+    return true;
+}
+
+unsigned int HTTPClient::GetResponseLength()
+{
+    //A 304 has no body
+    return isNotModified ? 0 : HostHTTPServer::body.length();
+}
+
+void HTTPClient::CompleteResponse()
+{
+    CloseConnection();
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_CLOSED;
+}
+
+void HTTPClient::abort()
+{
+    CloseConnection();
+    state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_CLOSED;
+}
+
+int HostHTTPStream::available()
+{
+    if (client->state != HTTPCLIENT_STATE::HTTPCLIENT_STATE_DATA)
+    {
+        return 0;
+    }
+    unsigned int remaining = client->GetResponseLength() - client->payloadIndex;
+    return (int)(remaining < HOST_HTTP_PAYLOAD_CHUNK ? remaining : HOST_HTTP_PAYLOAD_CHUNK);
+}
+
+int HostHTTPStream::read()
+{
+    uint8_t c;
+    return readBytes(&c, 1) == 1 ? c : -1;
+}
+
+size_t HostHTTPStream::readBytes(uint8_t* buffer, size_t length)
+{
+    size_t chunk = (size_t)available();
+    chunk = chunk < length ? chunk : length;
+    memcpy(buffer, HostHTTPServer::body.c_str() + client->payloadIndex, chunk);
+    client->payloadIndex += chunk;
+    HostHTTPServer::payloadBytes += chunk;
+    return chunk;
+}
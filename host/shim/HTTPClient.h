@@ -0,0 +1,131 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// HTTPClient.h
+// Host stand-in for the asynchronous HTTPClient of Free-ESPatHome. There is no network, every connection is
+// served by HostHTTPServer, which replays a scripted response in chunks like a slow TLS socket would.
+// Connecting resolves the name with WiFi.hostByName like WiFiClientSecure does, an IP address is not looked up.
+// The TLS handshake blocks Connect() for the time and heap it takes at 80 MHz, every connection does a full handshake.
+// The connection is closed after the response. GetStreamPtr() reads the payload straight from the connection,
+// HOST_HTTP_PAYLOAD_CHUNK bytes are available at a time, the state stays DATA like it does for the library.
+// A request with If-None-Match or If-Modified-Since matching the scripted ETag or Last-Modified header gets a 304.
+
+#pragma once
+#include "arduino.h"
+#include "WiFi.h"
+#include <vector>
+
+#define HTTP_SESSION_TIMEOUT_MS 15000
+#define HOST_HTTP_PAYLOAD_CHUNK 64
+#define HOST_TLS_FULL_HANDSHAKE_MS 1900 //ECDHE key exchange and certificate chain verification
+#define HOST_TLS_HANDSHAKE_HEAP 22000 //Certificate chain and key exchange, freed when the handshake is done
+#define HOST_TLS_CONNECTION_HEAP 20480 //Record buffers, 16 KB in and 4 KB out, held while connected
+
+#ifndef DEBUG_PL
+	#define DEBUG_PL(x)
+	#define DEBUG_P(x)
+#endif
+
+namespace HTTPCLIENT_STATEENUM
+{
+	enum HTTPCLIENT_STATE :uint8_t
+	{
+		HTTPCLIENT_STATE_INITIAL = 0,
+		HTTPCLIENT_STATE_CLOSED = 1,
+		HTTPCLIENT_STATE_FAILED = 2,
+		HTTPCLIENT_STATE_CONNECTED = 3,
+		HTTPCLIENT_STATE_REQUESTED = 4,
+		HTTPCLIENT_STATE_HEADERS = 5,
+		HTTPCLIENT_STATE_DATA = 6,
+	};
+}
+typedef HTTPCLIENT_STATEENUM::HTTPCLIENT_STATE HTTPCLIENT_STATE;
+
+class HostHTTPServer
+{
+public:
+	static void SetResponse(const uint16_t& status, const String& body);
+	static void AddResponseHeader(const String& key, const String& value);
+	static void SetConnectFailure(const bool& fail) { connectFailure = fail; }
+	static void SetContentLength(const bool& send) { sendContentLength = send; } //Without it the body ends when the connection closes
+	static uint32_t GetConnectCount() { return connectCount; }
+	static uint32_t GetRequestCount() { return requestCount; }
+	static uint32_t GetHandshakeCount() { return handshakeCount; }
+	static uint32_t GetNotModifiedCount() { return notModifiedCount; }
+	static uint32_t GetPayloadBytes() { return payloadBytes; }
+	static void Reset();
+private:
+	friend class HTTPClient;
+	friend class HostHTTPStream;
+	static String GetResponseHeader(const String& key);
+	static bool IsNotModified(const String& ifNoneMatch, const String& ifModifiedSince);
+	static uint16_t status;
+	static String body;
+	static std::vector<String> headerKeys;
+	static std::vector<String> headerValues;
+	static bool connectFailure;
+	static bool sendContentLength;
+	static uint32_t connectCount;
+	static uint32_t requestCount;
+	static uint32_t handshakeCount;
+	static uint32_t notModifiedCount;
+	static uint32_t payloadBytes;
+};
+
+class HTTPClient;
+
+class HostHTTPStream : public Stream
+{
+public:
+	HostHTTPStream(HTTPClient* client) : client(client) {}
+	int available();
+	int read();
+	size_t readBytes(uint8_t* buffer, size_t length);
+	using Stream::readBytes;
+private:
+	HTTPClient* client;
+};
+
+class HTTPClient
+{
+public:
+	HTTPClient(const bool& useTLS) : useTLS(useTLS) {}
+	virtual ~HTTPClient() { CloseConnection(); }
+	HTTPCLIENT_STATE GetState() { return state; }
+	bool Connect(const char* host, const uint16_t& port); //Resolves the host name first, an address is not looked up
+	void AddRequestHeader(const String& key, const String& value);
+	bool Request(const String& method, const String& uri, const String& data);
+	bool ReadResult(uint16_t* resultCode);
+	bool ReadHeaders(String& key, String& value);
+	bool ReadPayload();
+	Stream* GetStreamPtr() { return &stream; }
+	String GetBody() { return payload; }
+	unsigned long GetSessionStartMillis() { return sessionStartMillis; }
+	void abort();
+private:
+	friend class HostHTTPStream;
+	void CloseConnection();
+	void CompleteResponse();
+	unsigned int GetResponseLength();
+	bool useTLS;
+	bool isNotModified = false;
+	String ifNoneMatch;
+	String ifModifiedSince;
+	uint8_t* connectionBuffer = NULL;
+	uint8_t* handshakeBuffer = NULL;
+	HTTPCLIENT_STATE state = HTTPCLIENT_STATE::HTTPCLIENT_STATE_INITIAL;
+	unsigned long sessionStartMillis = 0;
+	size_t headerIndex = 0;
+	size_t payloadIndex = 0;
+	String payload;
+	HostHTTPStream stream = HostHTTPStream(this);
+};
@@ -0,0 +1,936 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "HostHal.h"
+#include "arduino.h"
+#include "driver/pcnt.h"
+#include "driver/gpio.h"
+#include "driver/adc.h"
+#include "driver/rmt.h"
+#include "HostOneWire.h"
+#include "esp_adc_cal.h"
+#include <cstdio>
+#include <vector>
+#include <malloc.h>
+
+HardwareSerial Serial;
+EspClass ESP;
+
+void HardwareSerial::print(const String& s)
+{
+    fputs(s.c_str(), stdout);
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    //What the host process had allocated at the first call is not part of the station heap
+    static size_t hostBase = mallinfo2().uordblks;
+    size_t used = mallinfo2().uordblks;
+    used = used > hostBase ? used - hostBase : 0;
+    return used < HOST_HEAP_SIZE ? (uint32_t)(HOST_HEAP_SIZE - used) : 0;
+}
+
+namespace HostHal
+{
+    static uint64_t virtualMicros = 0;
+    static uint16_t analogValues[HOSTHAL_MAX_PINS] = { 0 };
+    static uint16_t analogNoise[HOSTHAL_MAX_PINS] = { 0 };
+    static uint32_t noiseState = 1;
+    static uint64_t adcConversionCount = 0;
+    static std::function<void(void)> interruptHandlers[HOSTHAL_MAX_PINS];
+    static bool interruptsEnabled = true;
+    static float probeTemperatures[HOSTHAL_MAX_PROBES] = { 20.0f, HOSTHAL_PROBE_DISCONNECTED, HOSTHAL_PROBE_DISCONNECTED, HOSTHAL_PROBE_DISCONNECTED };
+    static uint64_t interruptCount = 0;
+
+    struct PulseSource
+    {
+        uint8_t pin;
+        uint32_t periodUs; //0 is off
+        uint64_t nextMicros;
+        uint64_t edgeCount;
+    };
+    static PulseSource pulseSource;
+
+    struct LatchedInterrupt
+    {
+        bool pending;
+        uint8_t pin;
+        uint64_t sinceMicros;
+        uint64_t dropped;
+        uint64_t delayed;
+        uint64_t maxLatencyMicros;
+    };
+    static LatchedInterrupt latchedInterrupt;
+
+    struct PcntUnit
+    {
+        bool configured;
+        bool running;
+        pcnt_config_t config;
+        int16_t count;
+    };
+    static PcntUnit pcntUnits[PCNT_UNIT_MAX];
+
+    struct RmtChannel
+    {
+        bool configured = false;
+        bool installed = false;
+        bool rxRunning = false;
+        rmt_config_t config;
+        uint16_t rxIdleThreshold = 0;
+        std::vector<rmt_item32_t> rxItems; //Last received frame, handed out once
+        bool rxPending = false;
+        uint64_t rxReadyMicros = 0;
+    };
+
+    static RmtChannel rmtChannels[RMT_CHANNEL_MAX];
+
+    struct AdcDigi
+    {
+        bool initialized;
+        bool running;
+        adc_digi_init_config_t init;
+        adc_digi_pattern_config_t pattern[ADC1_CHANNEL_MAX];
+        uint32_t patternCount;
+        uint32_t sampleFreqHz;
+        uint64_t producedUntilMicros; //Conversions up to this time are in the buffer or dropped
+        uint32_t buffered;
+        uint32_t patternIndex;
+        uint32_t leftover; //Conversions still in the driver buffer from before adc_digi_stop(), read first
+        uint16_t leftoverData;
+        bool startFailure;
+        bool stalled;
+    };
+    static AdcDigi adcDigi;
+    static const uint8_t adc1ChannelPins[ADC1_CHANNEL_MAX] = { 36, 37, 38, 39, 32, 33, 34, 35 };
+
+    uint64_t GetMicros()
+    {
+        return virtualMicros;
+    }
+
+    void SetMicros(const uint64_t& micros)
+    {
+        virtualMicros = micros;
+    }
+
+    static void CountPulse(const uint8_t& pin, const uint32_t& count)
+    {
+        for (int u = 0; u < PCNT_UNIT_MAX; u++)
+        {
+            PcntUnit& unit = pcntUnits[u];
+            if (unit.configured && unit.running && unit.config.pulse_gpio_num == pin && unit.config.neg_mode == PCNT_COUNT_INC)
+            {
+                //The counter restarts at zero when it reaches the high limit
+                int32_t limit = unit.config.counter_h_lim > 0 ? unit.config.counter_h_lim : 32767;
+                unit.count = (int16_t)(((int32_t)unit.count + (int32_t)(count % (uint32_t)limit)) % limit);
+            }
+        }
+    }
+
+    static void Edge(const uint8_t& pin)
+    {
+        CountPulse(pin, 1);
+        if (interruptsEnabled)
+        {
+            FireInterrupt(pin, 1);
+        }
+        else if (!latchedInterrupt.pending)
+        {
+            latchedInterrupt.pending = true;
+            latchedInterrupt.pin = pin;
+            latchedInterrupt.sinceMicros = virtualMicros;
+        }
+        else
+        {
+            latchedInterrupt.dropped++;
+        }
+    }
+
+    static void RunPulseSource(const uint64_t& untilMicros)
+    {
+        while (pulseSource.periodUs != 0 && pulseSource.nextMicros <= untilMicros)
+        {
+            virtualMicros = pulseSource.nextMicros;
+            pulseSource.nextMicros += pulseSource.periodUs;
+            pulseSource.edgeCount++;
+            Edge(pulseSource.pin);
+        }
+    }
+
+    void AdvanceMicros(const uint64_t& micros)
+    {
+        uint64_t untilMicros = virtualMicros + micros;
+        RunPulseSource(untilMicros);
+        virtualMicros = untilMicros;
+    }
+
+    void AdvanceMillis(const uint64_t& millis)
+    {
+        AdvanceMicros(millis * 1000);
+    }
+
+    void SetAnalogValue(const uint8_t& pin, const uint16_t& value)
+    {
+        if (pin < HOSTHAL_MAX_PINS)
+        {
+            analogValues[pin] = value;
+        }
+    }
+
+    uint16_t GetAnalogValue(const uint8_t& pin)
+    {
+        if (pin >= HOSTHAL_MAX_PINS)
+        {
+            return 0;
+        }
+        adcConversionCount++;
+        if (analogNoise[pin] == 0)
+        {
+            return analogValues[pin];
+        }
+        noiseState = noiseState * 1103515245 + 12345;
+        int32_t value = (int32_t)analogValues[pin] + (int32_t)((noiseState >> 16) % (2 * analogNoise[pin] + 1)) - (int32_t)analogNoise[pin];
+        return (uint16_t)std::min(std::max(value, (int32_t)0), (int32_t)4095);
+    }
+
+    void SetAnalogNoise(const uint8_t& pin, const uint16_t& amplitude)
+    {
+        if (pin < HOSTHAL_MAX_PINS)
+        {
+            analogNoise[pin] = amplitude;
+        }
+    }
+
+    uint64_t GetAdcConversionCount()
+    {
+        return adcConversionCount;
+    }
+
+    void SetAdcStartFailure(const bool& fail)
+    {
+        adcDigi.startFailure = fail;
+    }
+
+    void SetAdcStalled(const bool& stalled)
+    {
+        adcDigi.stalled = stalled;
+    }
+
+    void AttachInterrupt(const uint8_t& pin, std::function<void(void)> handler, const int& mode)
+    {
+        (void)mode;
+        if (pin < HOSTHAL_MAX_PINS)
+        {
+            interruptHandlers[pin] = handler;
+        }
+    }
+
+    void DetachInterrupt(const uint8_t& pin)
+    {
+        if (pin < HOSTHAL_MAX_PINS)
+        {
+            interruptHandlers[pin] = nullptr;
+        }
+    }
+
+    void FireInterrupt(const uint8_t& pin, const uint32_t& count)
+    {
+        if (pin < HOSTHAL_MAX_PINS && interruptHandlers[pin])
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                interruptHandlers[pin]();
+            }
+            interruptCount += count;
+        }
+    }
+
+    void PulsePin(const uint8_t& pin, const uint32_t& count, const uint32_t& periodUs)
+    {
+        CountPulse(pin, count);
+        if (periodUs == 0)
+        {
+            FireInterrupt(pin, count);
+            return;
+        }
+        for (uint32_t i = 0; i < count; i++)
+        {
+            FireInterrupt(pin, 1);
+            virtualMicros += periodUs;
+        }
+    }
+
+    uint64_t GetInterruptCount()
+    {
+        return interruptCount;
+    }
+
+    bool InterruptsEnabled()
+    {
+        return interruptsEnabled;
+    }
+
+    void SetInterruptsEnabled(const bool& enabled)
+    {
+        interruptsEnabled = enabled;
+        if (enabled && latchedInterrupt.pending)
+        {
+            latchedInterrupt.pending = false;
+            latchedInterrupt.delayed++;
+            uint64_t latency = virtualMicros - latchedInterrupt.sinceMicros;
+            latchedInterrupt.maxLatencyMicros = std::max(latchedInterrupt.maxLatencyMicros, latency);
+            FireInterrupt(latchedInterrupt.pin, 1);
+        }
+    }
+
+    void SetPulseSource(const uint8_t& pin, const uint32_t& periodUs)
+    {
+        pulseSource.pin = pin;
+        pulseSource.periodUs = periodUs;
+        pulseSource.nextMicros = virtualMicros + periodUs;
+    }
+
+    uint64_t GetPulseSourceEdgeCount()
+    {
+        return pulseSource.edgeCount;
+    }
+
+    uint64_t GetDroppedInterruptCount()
+    {
+        return latchedInterrupt.dropped;
+    }
+
+    uint64_t GetDelayedInterruptCount()
+    {
+        return latchedInterrupt.delayed;
+    }
+
+    uint64_t GetMaxInterruptLatencyMicros()
+    {
+        return latchedInterrupt.maxLatencyMicros;
+    }
+
+    void SetProbeTemperature(const float& temperatureC)
+    {
+        probeTemperatures[0] = temperatureC;
+    }
+
+    void SetProbeTemperature(const uint8_t& probe, const float& temperatureC)
+    {
+        if (probe < HOSTHAL_MAX_PROBES)
+        {
+            probeTemperatures[probe] = temperatureC;
+        }
+    }
+
+    float GetProbeTemperature(const uint8_t& probe)
+    {
+        return (probe < HOSTHAL_MAX_PROBES) ? probeTemperatures[probe] : HOSTHAL_PROBE_DISCONNECTED;
+    }
+
+    void Reset()
+    {
+        virtualMicros = 0;
+        interruptsEnabled = true;
+        probeTemperatures[0] = 20.0f;
+        for (int p = 1; p < HOSTHAL_MAX_PROBES; p++)
+        {
+            probeTemperatures[p] = HOSTHAL_PROBE_DISCONNECTED;
+        }
+        interruptCount = 0;
+        pulseSource = PulseSource();
+        latchedInterrupt = LatchedInterrupt();
+        noiseState = 1;
+        adcConversionCount = 0;
+        HostOneWire::Reset(true);
+        for (int c = 0; c < RMT_CHANNEL_MAX; c++)
+        {
+            rmtChannels[c] = RmtChannel();
+        }
+        adcDigi.initialized = false;
+        adcDigi.running = false;
+        adcDigi.leftover = 0;
+        adcDigi.startFailure = false;
+        adcDigi.stalled = false;
+        for (int u = 0; u < PCNT_UNIT_MAX; u++)
+        {
+            pcntUnits[u].configured = false;
+            pcntUnits[u].running = false;
+            pcntUnits[u].count = 0;
+        }
+        for (int i = 0; i < HOSTHAL_MAX_PINS; i++)
+        {
+            analogValues[i] = 0;
+            analogNoise[i] = 0;
+            interruptHandlers[i] = nullptr;
+        }
+    }
+}
+
+esp_err_t pcnt_unit_config(const pcnt_config_t* pcnt_config)
+{
+    if (pcnt_config == NULL || pcnt_config->unit >= PCNT_UNIT_MAX || pcnt_config->pulse_gpio_num >= HOSTHAL_MAX_PINS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::PcntUnit& unit = HostHal::pcntUnits[pcnt_config->unit];
+    unit.config = *pcnt_config;
+    unit.configured = true;
+    unit.running = true;
+    unit.count = 0;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_get_counter_value(pcnt_unit_t pcnt_unit, int16_t* count)
+{
+    if (pcnt_unit >= PCNT_UNIT_MAX || count == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *count = HostHal::pcntUnits[pcnt_unit].count;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_pause(pcnt_unit_t pcnt_unit)
+{
+    if (pcnt_unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::pcntUnits[pcnt_unit].running = false;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_resume(pcnt_unit_t pcnt_unit)
+{
+    if (pcnt_unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::pcntUnits[pcnt_unit].running = true;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_counter_clear(pcnt_unit_t pcnt_unit)
+{
+    if (pcnt_unit >= PCNT_UNIT_MAX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::pcntUnits[pcnt_unit].count = 0;
+    return ESP_OK;
+}
+
+esp_err_t pcnt_set_filter_value(pcnt_unit_t unit, uint16_t filter_val)
+{
+    return (unit < PCNT_UNIT_MAX && filter_val < 1024) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_filter_enable(pcnt_unit_t unit)
+{
+    return (unit < PCNT_UNIT_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t pcnt_filter_disable(pcnt_unit_t unit)
+{
+    return (unit < PCNT_UNIT_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_install_isr_service(int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    return ESP_OK;
+}
+
+esp_err_t gpio_set_intr_type(gpio_num_t gpio_num, gpio_int_type_t intr_type)
+{
+    return (gpio_num >= 0 && gpio_num < HOSTHAL_MAX_PINS && intr_type < GPIO_INTR_MAX) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_isr_handler_add(gpio_num_t gpio_num, gpio_isr_t isr_handler, void* args)
+{
+    if (gpio_num < 0 || gpio_num >= HOSTHAL_MAX_PINS || isr_handler == NULL)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::AttachInterrupt((uint8_t)gpio_num, std::bind(isr_handler, args), FALLING);
+    return ESP_OK;
+}
+
+esp_err_t gpio_isr_handler_remove(gpio_num_t gpio_num)
+{
+    if (gpio_num < 0 || gpio_num >= HOSTHAL_MAX_PINS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::DetachInterrupt((uint8_t)gpio_num);
+    return ESP_OK;
+}
+
+esp_err_t gpio_intr_enable(gpio_num_t gpio_num)
+{
+    return (gpio_num >= 0 && gpio_num < HOSTHAL_MAX_PINS) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_intr_disable(gpio_num_t gpio_num)
+{
+    return (gpio_num >= 0 && gpio_num < HOSTHAL_MAX_PINS) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_direction(gpio_num_t gpio_num, gpio_mode_t mode)
+{
+    (void)mode;
+    return (gpio_num >= 0 && gpio_num < HOSTHAL_MAX_PINS) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+esp_err_t gpio_set_pull_mode(gpio_num_t gpio_num, gpio_pull_mode_t pull)
+{
+    (void)pull;
+    return (gpio_num >= 0 && gpio_num < HOSTHAL_MAX_PINS) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+namespace HostHal
+{
+    struct RmtLevel
+    {
+        bool level;
+        uint32_t micros;
+    };
+
+    static void AddLevel(std::vector<RmtLevel>& levels, const bool& level, const uint32_t& micros)
+    {
+        if (micros == 0)
+        {
+            return;
+        }
+        if (!levels.empty() && levels.back().level == level)
+        {
+            levels.back().micros += micros;
+        }
+        else
+        {
+            levels.push_back({ level, micros });
+        }
+    }
+
+    //The frame a receive channel records of the bus levels: it starts at the first low level and ends at the
+    //first level longer than the idle threshold, which is stored with a duration of 0
+    static void RecordFrame(RmtChannel& rx, const std::vector<RmtLevel>& bus, const uint64_t& startMicros)
+    {
+        uint32_t tickDiv = rx.config.clk_div > 0 ? rx.config.clk_div : 1;
+        rx.rxItems.clear();
+        uint64_t endMicros = startMicros;
+        bool half = false;
+        rmt_item32_t item;
+        item.val = 0;
+        for (size_t i = 0; i < bus.size(); i++)
+        {
+            uint32_t ticks = (uint32_t)(((uint64_t)bus[i].micros * 80) / tickDiv);
+            bool idle = ticks >= rx.rxIdleThreshold || i == bus.size() - 1;
+            endMicros += idle ? ((uint64_t)rx.rxIdleThreshold * tickDiv) / 80 : bus[i].micros;
+            uint32_t duration = idle ? 0 : (ticks > 0x7FFF ? 0x7FFF : ticks);
+            if (!half)
+            {
+                item.level0 = bus[i].level;
+                item.duration0 = duration;
+            }
+            else
+            {
+                item.level1 = bus[i].level;
+                item.duration1 = duration;
+                rx.rxItems.push_back(item);
+                item.val = 0;
+            }
+            half = !half;
+            if (idle)
+            {
+                break;
+            }
+        }
+        if (half)
+        {
+            rx.rxItems.push_back(item);
+        }
+        rx.rxPending = true;
+        rx.rxReadyMicros = endMicros;
+    }
+}
+
+esp_err_t rmt_config(const rmt_config_t* rmt_param)
+{
+    if (rmt_param == NULL || rmt_param->channel >= RMT_CHANNEL_MAX || rmt_param->rmt_mode >= RMT_MODE_MAX || rmt_param->clk_div == 0 ||
+        rmt_param->gpio_num < 0 || rmt_param->gpio_num >= HOSTHAL_MAX_PINS)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::RmtChannel& channel = HostHal::rmtChannels[rmt_param->channel];
+    channel.config = *rmt_param;
+    channel.configured = true;
+    channel.rxIdleThreshold = (rmt_param->rmt_mode == RMT_MODE_RX) ? rmt_param->rx_config.idle_threshold : 0;
+    return ESP_OK;
+}
+
+esp_err_t rmt_driver_install(rmt_channel_t channel, size_t rx_buf_size, int intr_alloc_flags)
+{
+    (void)intr_alloc_flags;
+    if (channel >= RMT_CHANNEL_MAX || !HostHal::rmtChannels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (HostHal::rmtChannels[channel].installed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (HostHal::rmtChannels[channel].config.rmt_mode == RMT_MODE_RX && rx_buf_size == 0)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::rmtChannels[channel].installed = true;
+    return ESP_OK;
+}
+
+esp_err_t rmt_driver_uninstall(rmt_channel_t channel)
+{
+    if (channel >= RMT_CHANNEL_MAX || !HostHal::rmtChannels[channel].installed)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    HostHal::rmtChannels[channel] = HostHal::RmtChannel();
+    return ESP_OK;
+}
+
+esp_err_t rmt_get_ringbuf_handle(rmt_channel_t channel, RingbufHandle_t* buf_handle)
+{
+    if (channel >= RMT_CHANNEL_MAX || buf_handle == NULL || !HostHal::rmtChannels[channel].installed || HostHal::rmtChannels[channel].config.rmt_mode != RMT_MODE_RX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    *buf_handle = &HostHal::rmtChannels[channel];
+    return ESP_OK;
+}
+
+esp_err_t rmt_rx_start(rmt_channel_t channel, bool rx_idx_rst)
+{
+    if (channel >= RMT_CHANNEL_MAX || !HostHal::rmtChannels[channel].installed || HostHal::rmtChannels[channel].config.rmt_mode != RMT_MODE_RX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::rmtChannels[channel].rxRunning = true;
+    if (rx_idx_rst)
+    {
+        HostHal::rmtChannels[channel].rxPending = false;
+    }
+    return ESP_OK;
+}
+
+esp_err_t rmt_rx_stop(rmt_channel_t channel)
+{
+    if (channel >= RMT_CHANNEL_MAX || !HostHal::rmtChannels[channel].installed)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::rmtChannels[channel].rxRunning = false;
+    return ESP_OK;
+}
+
+esp_err_t rmt_set_rx_idle_thresh(rmt_channel_t channel, uint16_t thresh)
+{
+    if (channel >= RMT_CHANNEL_MAX || !HostHal::rmtChannels[channel].configured)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::rmtChannels[channel].rxIdleThreshold = thresh;
+    return ESP_OK;
+}
+
+esp_err_t rmt_write_items(rmt_channel_t channel, const rmt_item32_t* rmt_item, int item_num, bool wait_tx_done)
+{
+    (void)wait_tx_done;
+    if (channel >= RMT_CHANNEL_MAX || rmt_item == NULL || item_num <= 0 || !HostHal::rmtChannels[channel].installed ||
+        HostHal::rmtChannels[channel].config.rmt_mode != RMT_MODE_TX)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    const rmt_config_t& tx = HostHal::rmtChannels[channel].config;
+
+    //Levels driven by the transmitter, up to the first duration of 0; the open drain output is released after that
+    std::vector<HostHal::RmtLevel> master;
+    for (int i = 0; i < item_num; i++)
+    {
+        if (rmt_item[i].duration0 == 0)
+        {
+            break;
+        }
+        HostHal::AddLevel(master, rmt_item[i].level0, (rmt_item[i].duration0 * tx.clk_div) / 80);
+        if (rmt_item[i].duration1 == 0)
+        {
+            break;
+        }
+        HostHal::AddLevel(master, rmt_item[i].level1, (rmt_item[i].duration1 * tx.clk_div) / 80);
+    }
+
+    //Bus levels: the probes answer each low level of the master, as a reset pulse or a time slot
+    const uint32_t releasedMicros = 1000;
+    uint64_t startMicros = HostHal::GetMicros();
+    std::vector<HostHal::RmtLevel> bus;
+    for (size_t i = 0; i < master.size(); i++)
+    {
+        if (master[i].level)
+        {
+            HostHal::AddLevel(bus, true, master[i].micros);
+            HostHal::AdvanceMicros(master[i].micros);
+            continue;
+        }
+        //After the last item the line stays released
+        uint32_t lowMicros = master[i].micros;
+        uint32_t highMicros = (i + 2 < master.size()) ? master[i + 1].micros : releasedMicros;
+        uint32_t slotMicros = lowMicros + highMicros;
+        if (lowMicros >= 480)
+        {
+            //Presence pulse 30us after the release, 120us long
+            bool presence = HostOneWire::Reset();
+            HostHal::AddLevel(bus, false, lowMicros);
+            if (presence && highMicros > 150)
+            {
+                HostHal::AddLevel(bus, true, 30);
+                HostHal::AddLevel(bus, false, 120);
+                HostHal::AddLevel(bus, true, highMicros - 150);
+            }
+            else
+            {
+                HostHal::AddLevel(bus, true, highMicros);
+            }
+        }
+        else if (lowMicros >= 15)
+        {
+            //Still low at the sample point: write 0
+            HostOneWire::Slot(false);
+            HostHal::AddLevel(bus, false, lowMicros);
+            HostHal::AddLevel(bus, true, highMicros);
+        }
+        else
+        {
+            //Write 1 or read slot, a probe sending a 0 holds the line low for 30us
+            uint32_t heldMicros = HostOneWire::Slot(true) ? lowMicros : (slotMicros < 30 ? slotMicros : (lowMicros > 30 ? lowMicros : 30));
+            HostHal::AddLevel(bus, false, heldMicros);
+            HostHal::AddLevel(bus, true, slotMicros - heldMicros);
+        }
+        //The transmission takes the time of the items
+        HostHal::AdvanceMicros(lowMicros + ((i + 1 < master.size()) ? master[i + 1].micros : 0));
+        i++;
+    }
+    if (bus.empty() || bus.back().level == false)
+    {
+        HostHal::AddLevel(bus, true, releasedMicros);
+    }
+
+    for (int c = 0; c < RMT_CHANNEL_MAX; c++)
+    {
+        HostHal::RmtChannel& rx = HostHal::rmtChannels[c];
+        if (rx.installed && rx.rxRunning && rx.config.rmt_mode == RMT_MODE_RX && rx.config.gpio_num == tx.gpio_num)
+        {
+            HostHal::RecordFrame(rx, bus, startMicros);
+        }
+    }
+    return ESP_OK;
+}
+
+esp_err_t rmt_wait_tx_done(rmt_channel_t channel, TickType_t wait_time)
+{
+    (void)wait_time;
+    return (channel < RMT_CHANNEL_MAX && HostHal::rmtChannels[channel].installed) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+void* xRingbufferReceive(RingbufHandle_t xRingbuffer, size_t* pxItemSize, TickType_t xTicksToWait)
+{
+    HostHal::RmtChannel* rx = (HostHal::RmtChannel*)xRingbuffer;
+    if (rx == NULL || pxItemSize == NULL)
+    {
+        return NULL;
+    }
+    if (!rx->rxPending)
+    {
+        HostHal::AdvanceMillis(xTicksToWait == portMAX_DELAY ? 0 : xTicksToWait);
+        *pxItemSize = 0;
+        return NULL;
+    }
+    //The frame is complete once the line has been idle for the threshold
+    if (HostHal::GetMicros() < rx->rxReadyMicros)
+    {
+        HostHal::AdvanceMicros(rx->rxReadyMicros - HostHal::GetMicros());
+    }
+    rx->rxPending = false;
+    *pxItemSize = rx->rxItems.size() * sizeof(rmt_item32_t);
+    return rx->rxItems.data();
+}
+
+void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void* pvItem)
+{
+    (void)xRingbuffer;
+    (void)pvItem;
+}
+
+esp_err_t adc_digi_initialize(const adc_digi_init_config_t* init_config)
+{
+    if (init_config == NULL || init_config->adc2_chan_mask != 0 || init_config->max_store_buf_size < SOC_ADC_DIGI_RESULT_BYTES)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    HostHal::adcDigi.init = *init_config;
+    HostHal::adcDigi.initialized = true;
+    HostHal::adcDigi.running = false;
+    HostHal::adcDigi.patternCount = 0;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_controller_configure(const adc_digi_configuration_t* config)
+{
+    if (!HostHal::adcDigi.initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (config == NULL || config->pattern_num == 0 || config->pattern_num > ADC1_CHANNEL_MAX || config->adc_pattern == NULL ||
+        config->sample_freq_hz < 20000 || config->sample_freq_hz > 2000000 || config->conv_mode != ADC_CONV_SINGLE_UNIT_1)
+    {
+        return ESP_ERR_INVALID_ARG;
+    }
+    for (uint32_t i = 0; i < config->pattern_num; i++)
+    {
+        if (config->adc_pattern[i].unit != 0 || config->adc_pattern[i].channel >= ADC1_CHANNEL_MAX)
+        {
+            return ESP_ERR_INVALID_ARG;
+        }
+        HostHal::adcDigi.pattern[i] = config->adc_pattern[i];
+    }
+    HostHal::adcDigi.patternCount = config->pattern_num;
+    HostHal::adcDigi.sampleFreqHz = config->sample_freq_hz;
+    return ESP_OK;
+}
+
+//Conversions produced since the last call go to the driver buffer, what does not fit is lost
+static bool ProduceAdcConversions(HostHal::AdcDigi& adc)
+{
+    uint64_t now = HostHal::GetMicros();
+    uint64_t produced = adc.stalled ? 0 : ((now - adc.producedUntilMicros) * adc.sampleFreqHz) / 1000000;
+    adc.producedUntilMicros = adc.stalled ? now : adc.producedUntilMicros + (produced * 1000000) / adc.sampleFreqHz;
+    uint32_t capacity = adc.init.max_store_buf_size / SOC_ADC_DIGI_RESULT_BYTES - adc.leftover;
+    if (adc.buffered + produced > capacity)
+    {
+        adc.buffered = capacity;
+        return true;
+    }
+    adc.buffered += (uint32_t)produced;
+    return false;
+}
+
+esp_err_t adc_digi_start(void)
+{
+    if (!HostHal::adcDigi.initialized || HostHal::adcDigi.patternCount == 0)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    if (HostHal::adcDigi.startFailure)
+    {
+        return ESP_FAIL;
+    }
+    HostHal::adcDigi.running = true;
+    HostHal::adcDigi.producedUntilMicros = HostHal::GetMicros();
+    HostHal::adcDigi.buffered = 0;
+    HostHal::adcDigi.patternIndex = 0;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_stop(void)
+{
+    if (!HostHal::adcDigi.initialized)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    //The conversions in the driver buffer stay there, with the value of the pin when they were taken
+    HostHal::AdcDigi& adc = HostHal::adcDigi;
+    if (adc.running)
+    {
+        ProduceAdcConversions(adc);
+        adc.leftover += adc.buffered;
+        adc.leftoverData = HostHal::GetAnalogValue(HostHal::adc1ChannelPins[adc.pattern[adc.patternIndex].channel]) & 0xFFF;
+    }
+    adc.running = false;
+    adc.buffered = 0;
+    return ESP_OK;
+}
+
+esp_err_t adc_digi_read_bytes(uint8_t* buf, uint32_t length_max, uint32_t* out_length, uint32_t timeout_ms)
+{
+    (void)timeout_ms;
+    HostHal::AdcDigi& adc = HostHal::adcDigi;
+    if (!adc.initialized || buf == NULL || out_length == NULL)
+    {
+        return ESP_ERR_INVALID_STATE;
+    }
+    *out_length = 0;
+    bool overflow = false;
+    if (adc.running)
+    {
+        overflow = ProduceAdcConversions(adc);
+    }
+    uint32_t conversions = std::min(adc.leftover + adc.buffered, length_max / SOC_ADC_DIGI_RESULT_BYTES);
+    for (uint32_t i = 0; i < conversions; i++)
+    {
+        const adc_digi_pattern_config_t& pattern = adc.pattern[adc.patternIndex];
+        adc.patternIndex = (adc.patternIndex + 1) % adc.patternCount;
+        adc_digi_output_data_t data;
+        data.val = 0;
+        data.type1.channel = pattern.channel;
+        if (adc.leftover > 0)
+        {
+            data.type1.data = adc.leftoverData;
+            adc.leftover--;
+        }
+        else
+        {
+            data.type1.data = HostHal::GetAnalogValue(HostHal::adc1ChannelPins[pattern.channel]) & 0xFFF;
+            adc.buffered--;
+        }
+        memcpy(buf + i * SOC_ADC_DIGI_RESULT_BYTES, &data, SOC_ADC_DIGI_RESULT_BYTES);
+    }
+    *out_length = conversions * SOC_ADC_DIGI_RESULT_BYTES;
+    if (conversions == 0)
+    {
+        return ESP_ERR_TIMEOUT;
+    }
+    return overflow ? ESP_ERR_INVALID_STATE : ESP_OK;
+}
+
+esp_err_t adc_digi_deinitialize(void)
+{
+    HostHal::adcDigi.initialized = false;
+    HostHal::adcDigi.running = false;
+    HostHal::adcDigi.leftover = 0;
+    return ESP_OK;
+}
+
+esp_adc_cal_value_t esp_adc_cal_characterize(adc_unit_t adc_num, adc_atten_t atten, adc_bits_width_t bit_width, uint32_t default_vref, esp_adc_cal_characteristics_t* chars)
+{
+    chars->adc_num = adc_num;
+    chars->atten = atten;
+    chars->bit_width = bit_width;
+    chars->vref = default_vref;
+    chars->coeff_a = 3300;
+    chars->coeff_b = 0;
+    return ESP_ADC_CAL_VAL_EFUSE_VREF;
+}
+
+uint32_t esp_adc_cal_raw_to_voltage(uint32_t adc_reading, const esp_adc_cal_characteristics_t* chars)
+{
+    return (adc_reading * chars->coeff_a + 2047) / 4095 + chars->coeff_b;
+}
@@ -0,0 +1,75 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// HostHal.h
+// Virtual hardware behind the Arduino shim: a virtual clock, scripted ADC pins, interrupt injection and
+// scripted OneWire temperature probes (on the bus model in HostOneWire.h). Nothing here runs in real time, time only moves when asked to.
+
+#ifndef _HOSTHAL_h
+#define _HOSTHAL_h
+
+#include <cstdint>
+#include <functional>
+
+#define HOSTHAL_MAX_PINS 40
+#define HOSTHAL_MAX_PROBES 4
+#define HOSTHAL_PROBE_DISCONNECTED -127.0f
+
+namespace HostHal
+{
+	//Virtual clock, in microseconds since "boot"
+	uint64_t GetMicros();
+	void SetMicros(const uint64_t& micros);
+	void AdvanceMicros(const uint64_t& micros);
+	void AdvanceMillis(const uint64_t& millis);
+
+	//Analog inputs
+	void SetAnalogValue(const uint8_t& pin, const uint16_t& value);
+	uint16_t GetAnalogValue(const uint8_t& pin);
+	//Every conversion of the pin gets a deterministic pseudo random offset of -amplitude..amplitude
+	void SetAnalogNoise(const uint8_t& pin, const uint16_t& amplitude);
+	uint64_t GetAdcConversionCount();
+	//ADC DMA faults: adc_digi_start() fails, or the DMA runs without delivering conversions
+	void SetAdcStartFailure(const bool& fail);
+	void SetAdcStalled(const bool& stalled);
+
+	//Interrupts
+	void AttachInterrupt(const uint8_t& pin, std::function<void(void)> handler, const int& mode);
+	void DetachInterrupt(const uint8_t& pin);
+	//Runs the attached handler of the pin count times, at the current virtual time
+	void FireInterrupt(const uint8_t& pin, const uint32_t& count = 1);
+	//Falling edges on a pin: counted by the pulse counter units on the pin and dispatched to its interrupt handler.
+	//With a period the edges are that many microseconds apart and the clock moves count * period, else they are simultaneous.
+	void PulsePin(const uint8_t& pin, const uint32_t& count = 1, const uint32_t& periodUs = 0);
+	uint64_t GetInterruptCount();
+	//While interrupts are disabled an edge is latched and dispatched when they are enabled again, like the GPIO
+	//interrupt status of the ESP32. A second edge before that is lost for the interrupt handler, the pulse counter
+	//units still count it.
+	bool InterruptsEnabled();
+	void SetInterruptsEnabled(const bool& enabled);
+	//Periodic falling edges on a pin, dispatched at their own time whenever the clock moves. A period of 0 stops it.
+	void SetPulseSource(const uint8_t& pin, const uint32_t& periodUs);
+	uint64_t GetPulseSourceEdgeCount();
+	uint64_t GetDroppedInterruptCount();
+	uint64_t GetDelayedInterruptCount();
+	uint64_t GetMaxInterruptLatencyMicros();
+
+	//OneWire temperature probes, a value outside -55..125 simulates a disconnected probe.
+	//Probe 0 is connected after Reset(), the others are not.
+	void SetProbeTemperature(const float& temperatureC);
+	void SetProbeTemperature(const uint8_t& probe, const float& temperatureC);
+	float GetProbeTemperature(const uint8_t& probe = 0);
+
+	void Reset();
+}
+
+#endif
@@ -0,0 +1,338 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "HostOneWire.h"
+#include "HostHal.h"
+#include <cmath>
+#include <cstring>
+
+namespace HostOneWire
+{
+    enum Phase
+    {
+        PHASE_IDLE,
+        PHASE_ROM_COMMAND,
+        PHASE_MATCH_ROM,
+        PHASE_SEARCH,
+        PHASE_READ_ROM,
+        PHASE_FUNCTION_COMMAND,
+        PHASE_CONVERTING,
+        PHASE_READ_SCRATCHPAD,
+        PHASE_WRITE_SCRATCHPAD,
+        PHASE_READ_POWER,
+    };
+
+    struct Device
+    {
+        uint8_t rom[8];
+        uint8_t scratchpad[9];
+        uint64_t conversionEndMicros;
+        bool selected;
+    };
+
+    static Device devices[HOSTHAL_MAX_PROBES];
+    static Phase phase = PHASE_IDLE;
+    static uint8_t shiftByte = 0;
+    static uint8_t shiftBits = 0;
+    static uint16_t bitIndex = 0; //Bit of the ROM or scratchpad, or byte of a write scratchpad
+    static uint8_t searchStep = 0; //Bit, complement, direction
+    static uint32_t searchCount = 0;
+    static uint32_t scratchpadReadCount = 0;
+
+    uint8_t Crc8(const uint8_t* data, const uint8_t& len)
+    {
+        //Dallas/Maxim CRC, x^8 + x^5 + x^4 + 1
+        uint8_t crc = 0;
+        for (uint8_t i = 0; i < len; i++)
+        {
+            uint8_t inbyte = data[i];
+            for (uint8_t j = 0; j < 8; j++)
+            {
+                uint8_t mix = (crc ^ inbyte) & 0x01;
+                crc >>= 1;
+                if (mix)
+                {
+                    crc ^= 0x8C;
+                }
+                inbyte >>= 1;
+            }
+        }
+        return crc;
+    }
+
+    void GetRom(const uint8_t& probe, uint8_t* rom)
+    {
+        //Family 0x28, serial "HOST" + probe. The probe number is bit reversed, the ROM search (least significant
+        //bit first, 0 before 1) then finds the probes in the order of their number.
+        const uint8_t base[7] = { 0x28, 0x48, 0x4F, 0x53, 0x54, 0x00, 0x00 };
+        memcpy(rom, base, sizeof(base));
+        for (uint8_t bit = 0; bit < 8; bit++)
+        {
+            rom[5] |= (uint8_t)(((probe >> bit) & 0x01) << (7 - bit));
+        }
+        rom[7] = Crc8(rom, 7);
+    }
+
+    static bool Present(const uint8_t& probe)
+    {
+        float t = HostHal::GetProbeTemperature(probe);
+        return (t >= -55 && t <= 125);
+    }
+
+    static uint8_t Resolution(const Device& device)
+    {
+        return ((device.scratchpad[4] >> 5) & 0x03) + 9;
+    }
+
+    static bool GetBit(const uint8_t* data, const uint16_t& bit)
+    {
+        return (data[bit / 8] >> (bit % 8)) & 0x01;
+    }
+
+    //Wired AND of the selected probes, each driving the given bit of its data (the line stays high without probes)
+    static bool BusBit(const bool& fromRom, const uint16_t& bit, const bool& complement)
+    {
+        bool line = true;
+        for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+        {
+            if (devices[p].selected)
+            {
+                bool value = GetBit(fromRom ? devices[p].rom : devices[p].scratchpad, bit);
+                line = line && (complement ? !value : value);
+            }
+        }
+        return line;
+    }
+
+    static void StartConversion()
+    {
+        for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+        {
+            Device& device = devices[p];
+            if (!device.selected)
+            {
+                continue;
+            }
+            uint8_t resolution = Resolution(device);
+            //1/16 degree steps, the bits below the resolution are zero
+            int16_t raw = (int16_t)floorf(HostHal::GetProbeTemperature(p) * 16.0f);
+            raw &= (int16_t)~((1 << (12 - resolution)) - 1);
+            device.scratchpad[0] = (uint8_t)(raw & 0xFF);
+            device.scratchpad[1] = (uint8_t)((raw >> 8) & 0xFF);
+            device.scratchpad[8] = Crc8(device.scratchpad, 8);
+            device.conversionEndMicros = HostHal::GetMicros() + (93750ULL << (resolution - 9));
+        }
+    }
+
+    static void HandleByte(const uint8_t& value)
+    {
+        switch (phase)
+        {
+        case PHASE_ROM_COMMAND:
+            bitIndex = 0;
+            switch (value)
+            {
+            case 0xCC: //Skip ROM
+                phase = PHASE_FUNCTION_COMMAND;
+                break;
+            case 0x55: //Match ROM
+                phase = PHASE_MATCH_ROM;
+                break;
+            case 0xF0: //Search ROM
+                searchCount++;
+                searchStep = 0;
+                phase = PHASE_SEARCH;
+                break;
+            case 0x33: //Read ROM
+                phase = PHASE_READ_ROM;
+                break;
+            default:
+                phase = PHASE_IDLE;
+                break;
+            }
+            break;
+        case PHASE_FUNCTION_COMMAND:
+            bitIndex = 0;
+            switch (value)
+            {
+            case 0x44: //Convert T
+                StartConversion();
+                phase = PHASE_CONVERTING;
+                break;
+            case 0xBE: //Read scratchpad
+                scratchpadReadCount++;
+                phase = PHASE_READ_SCRATCHPAD;
+                break;
+            case 0x4E: //Write scratchpad: TH, TL, configuration
+                phase = PHASE_WRITE_SCRATCHPAD;
+                break;
+            case 0xB4: //Read power supply
+                phase = PHASE_READ_POWER;
+                break;
+            default:
+                phase = PHASE_IDLE;
+                break;
+            }
+            break;
+        case PHASE_WRITE_SCRATCHPAD:
+            for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+            {
+                if (devices[p].selected)
+                {
+                    devices[p].scratchpad[2 + bitIndex] = (bitIndex == 2) ? (uint8_t)((value & 0x60) | 0x1F) : value;
+                    devices[p].scratchpad[8] = Crc8(devices[p].scratchpad, 8);
+                }
+            }
+            if (++bitIndex >= 3)
+            {
+                phase = PHASE_IDLE;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    bool Reset()
+    {
+        bool presence = false;
+        for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+        {
+            devices[p].selected = Present(p);
+            presence = presence || devices[p].selected;
+        }
+        phase = presence ? PHASE_ROM_COMMAND : PHASE_IDLE;
+        shiftByte = 0;
+        shiftBits = 0;
+        bitIndex = 0;
+        return presence;
+    }
+
+    bool Slot(const bool& WriteOne)
+    {
+        bool line = WriteOne;
+        switch (phase)
+        {
+        case PHASE_ROM_COMMAND:
+        case PHASE_FUNCTION_COMMAND:
+        case PHASE_WRITE_SCRATCHPAD:
+            shiftByte |= (uint8_t)((WriteOne ? 1 : 0) << shiftBits);
+            if (++shiftBits == 8)
+            {
+                uint8_t value = shiftByte;
+                shiftByte = 0;
+                shiftBits = 0;
+                HandleByte(value);
+            }
+            break;
+        case PHASE_MATCH_ROM:
+            for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+            {
+                if (devices[p].selected && GetBit(devices[p].rom, bitIndex) != WriteOne)
+                {
+                    devices[p].selected = false;
+                }
+            }
+            if (++bitIndex == 64)
+            {
+                bitIndex = 0;
+                phase = PHASE_FUNCTION_COMMAND;
+            }
+            break;
+        case PHASE_SEARCH:
+            if (searchStep < 2)
+            {
+                line = WriteOne && BusBit(true, bitIndex, searchStep == 1);
+                searchStep++;
+                break;
+            }
+            //Direction written by the master, the probes with the other bit stop taking part
+            for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+            {
+                if (devices[p].selected && GetBit(devices[p].rom, bitIndex) != WriteOne)
+                {
+                    devices[p].selected = false;
+                }
+            }
+            searchStep = 0;
+            if (++bitIndex == 64)
+            {
+                bitIndex = 0;
+                phase = PHASE_FUNCTION_COMMAND;
+            }
+            break;
+        case PHASE_READ_ROM:
+            line = WriteOne && BusBit(true, bitIndex, false);
+            if (++bitIndex == 64)
+            {
+                bitIndex = 0;
+                phase = PHASE_FUNCTION_COMMAND;
+            }
+            break;
+        case PHASE_READ_SCRATCHPAD:
+            line = WriteOne && (bitIndex >= 72 || BusBit(false, bitIndex, false));
+            bitIndex++;
+            break;
+        case PHASE_CONVERTING:
+            //Read slots return 0 until every selected probe is done
+            for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+            {
+                if (devices[p].selected && HostHal::GetMicros() < devices[p].conversionEndMicros)
+                {
+                    line = false;
+                }
+            }
+            break;
+        case PHASE_READ_POWER:
+        case PHASE_IDLE:
+        default:
+            //Externally powered probes, or nobody listening
+            break;
+        }
+        return line;
+    }
+
+    uint32_t GetSearchCount()
+    {
+        return searchCount;
+    }
+
+    uint32_t GetScratchpadReadCount()
+    {
+        return scratchpadReadCount;
+    }
+
+    void ResetStatistics()
+    {
+        searchCount = 0;
+        scratchpadReadCount = 0;
+    }
+
+    void Reset(const bool& powerOn)
+    {
+        //85 degrees until the first conversion, 12 bit resolution
+        const uint8_t scratchpad[8] = { 0x50, 0x05, 0x4B, 0x46, 0x7F, 0xFF, 0x0C, 0x10 };
+        for (uint8_t p = 0; p < HOSTHAL_MAX_PROBES; p++)
+        {
+            GetRom(p, devices[p].rom);
+            if (powerOn)
+            {
+                memcpy(devices[p].scratchpad, scratchpad, sizeof(scratchpad));
+                devices[p].scratchpad[8] = Crc8(scratchpad, 8);
+                devices[p].conversionEndMicros = 0;
+            }
+            devices[p].selected = false;
+        }
+        phase = PHASE_IDLE;
+        ResetStatistics();
+    }
+}
@@ -0,0 +1,44 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// HostOneWire.h
+// Simulated OneWire bus with a DS18B20 for every connected HostHal probe, at the level of time slots. The OneWire
+// shim (bit banged) and the RMT shim both drive it, the DallasTemperature shim is built on the OneWire shim.
+// The model does not move the clock, the transports do.
+
+#ifndef _HOSTONEWIRE_h
+#define _HOSTONEWIRE_h
+
+#include <cstdint>
+
+namespace HostOneWire
+{
+	//Reset pulse, true when a probe answers with a presence pulse
+	bool Reset();
+	//One time slot. WriteOne is false when the master holds the line low (write 0), true for a write 1 or read
+	//slot. Returns the level of the line at the sample point, 15us into the slot.
+	bool Slot(const bool& WriteOne);
+
+	//ROM code of probe n, with a valid CRC
+	void GetRom(const uint8_t& probe, uint8_t* rom);
+	uint8_t Crc8(const uint8_t* data, const uint8_t& len);
+
+	//Statistics
+	uint32_t GetSearchCount();
+	uint32_t GetScratchpadReadCount();
+	void ResetStatistics();
+
+	//Power on state of all probes, called by HostHal::Reset
+	void Reset(const bool& powerOn);
+}
+
+#endif
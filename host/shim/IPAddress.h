@@ -0,0 +1,39 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// IPAddress.h
+// Host stand-in for the IPv4 address class of the Arduino core
+
+#ifndef _IPADDRESS_HOST_h
+#define _IPADDRESS_HOST_h
+
+#include <stdint.h>
+#include "WString.h"
+
+class IPAddress
+{
+public:
+	IPAddress() : address(0) {}
+	IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth) : address((uint32_t)first | ((uint32_t)second << 8) | ((uint32_t)third << 16) | ((uint32_t)fourth << 24)) {}
+	IPAddress(uint32_t address) : address(address) {}
+	operator uint32_t() const { return address; }
+	uint8_t operator[](int index) const { return (uint8_t)(address >> (index * 8)); }
+	bool operator==(const IPAddress& rhs) const { return address == rhs.address; }
+	bool operator!=(const IPAddress& rhs) const { return address != rhs.address; }
+	bool fromString(const char* text);
+	bool fromString(const String& text) { return fromString(text.c_str()); }
+	String toString() const;
+private:
+	uint32_t address; //Network order, the first octet in the low byte like the core
+};
+
+#endif
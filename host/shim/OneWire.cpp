@@ -0,0 +1,206 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "OneWire.h"
+#include "HostOneWire.h"
+
+uint8_t OneWire::reset(void)
+{
+    //480us low with interrupts enabled, the presence sample 70us later with interrupts disabled
+    delayMicroseconds(480);
+    noInterrupts();
+    bool presence = HostOneWire::Reset();
+    delayMicroseconds(70);
+    interrupts();
+    delayMicroseconds(410);
+    return presence ? 1 : 0;
+}
+
+void OneWire::write_bit(uint8_t v)
+{
+    noInterrupts();
+    HostOneWire::Slot(v & 1);
+    if (v & 1)
+    {
+        delayMicroseconds(10);
+        interrupts();
+        delayMicroseconds(55);
+    }
+    else
+    {
+        delayMicroseconds(65);
+        interrupts();
+        delayMicroseconds(5);
+    }
+}
+
+uint8_t OneWire::read_bit(void)
+{
+    noInterrupts();
+    delayMicroseconds(13);
+    uint8_t r = HostOneWire::Slot(true) ? 1 : 0;
+    interrupts();
+    delayMicroseconds(53);
+    return r;
+}
+
+void OneWire::write(uint8_t v, uint8_t power)
+{
+    for (uint8_t bitMask = 0x01; bitMask; bitMask <<= 1)
+    {
+        write_bit((bitMask & v) ? 1 : 0);
+    }
+}
+
+void OneWire::write_bytes(const uint8_t* buf, uint16_t count, bool power)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        write(buf[i]);
+    }
+}
+
+uint8_t OneWire::read(void)
+{
+    uint8_t r = 0;
+    for (uint8_t bitMask = 0x01; bitMask; bitMask <<= 1)
+    {
+        if (read_bit())
+        {
+            r |= bitMask;
+        }
+    }
+    return r;
+}
+
+void OneWire::read_bytes(uint8_t* buf, uint16_t count)
+{
+    for (uint16_t i = 0; i < count; i++)
+    {
+        buf[i] = read();
+    }
+}
+
+void OneWire::select(const uint8_t rom[8])
+{
+    write(0x55);
+    for (uint8_t i = 0; i < 8; i++)
+    {
+        write(rom[i]);
+    }
+}
+
+void OneWire::skip(void)
+{
+    write(0xCC);
+}
+
+void OneWire::reset_search()
+{
+    LastDiscrepancy = 0;
+    LastDeviceFlag = false;
+    LastFamilyDiscrepancy = 0;
+    memset(ROM_NO, 0, sizeof(ROM_NO));
+}
+
+bool OneWire::search(uint8_t* newAddr, bool search_mode)
+{
+    //Maxim application note 187, as in the library
+    uint8_t id_bit_number = 1;
+    uint8_t last_zero = 0;
+    uint8_t rom_byte_number = 0;
+    uint8_t rom_byte_mask = 1;
+    bool search_result = false;
+
+    if (!LastDeviceFlag)
+    {
+        if (!reset())
+        {
+            reset_search();
+            return false;
+        }
+        write(search_mode ? 0xF0 : 0xEC);
+        do
+        {
+            uint8_t id_bit = read_bit();
+            uint8_t cmp_id_bit = read_bit();
+            if (id_bit == 1 && cmp_id_bit == 1)
+            {
+                break;
+            }
+            uint8_t search_direction;
+            if (id_bit != cmp_id_bit)
+            {
+                search_direction = id_bit;
+            }
+            else
+            {
+                if (id_bit_number < LastDiscrepancy)
+                {
+                    search_direction = (ROM_NO[rom_byte_number] & rom_byte_mask) > 0;
+                }
+                else
+                {
+                    search_direction = (id_bit_number == LastDiscrepancy);
+                }
+                if (search_direction == 0)
+                {
+                    last_zero = id_bit_number;
+                    if (last_zero < 9)
+                    {
+                        LastFamilyDiscrepancy = last_zero;
+                    }
+                }
+            }
+            if (search_direction == 1)
+            {
+                ROM_NO[rom_byte_number] |= rom_byte_mask;
+            }
+            else
+            {
+                ROM_NO[rom_byte_number] &= ~rom_byte_mask;
+            }
+            write_bit(search_direction);
+            id_bit_number++;
+            rom_byte_mask <<= 1;
+            if (rom_byte_mask == 0)
+            {
+                rom_byte_number++;
+                rom_byte_mask = 1;
+            }
+        } while (rom_byte_number < 8);
+
+        if (id_bit_number >= 65)
+        {
+            LastDiscrepancy = last_zero;
+            if (LastDiscrepancy == 0)
+            {
+                LastDeviceFlag = true;
+            }
+            search_result = true;
+        }
+    }
+    if (!search_result || !ROM_NO[0])
+    {
+        LastDiscrepancy = 0;
+        LastDeviceFlag = false;
+        LastFamilyDiscrepancy = 0;
+        return false;
+    }
+    memcpy(newAddr, ROM_NO, sizeof(ROM_NO));
+    return true;
+}
+
+uint8_t OneWire::crc8(const uint8_t* addr, uint8_t len)
+{
+    return HostOneWire::Crc8(addr, len);
+}
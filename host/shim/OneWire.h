@@ -0,0 +1,45 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// OneWire.h
+// Host stand-in for the OneWire library, bit banged on the HostOneWire bus model. The time slots keep the
+// timing and the interrupt masking of the library on the ESP32, so masked interrupts show up in the benchmarks.
+
+#pragma once
+#include "arduino.h"
+
+class OneWire
+{
+public:
+	OneWire(uint8_t pin) : pin(pin) { reset_search(); }
+	uint8_t GetPin() const { return pin; }
+
+	uint8_t reset(void);
+	void select(const uint8_t rom[8]);
+	void skip(void);
+	void write(uint8_t v, uint8_t power = 0);
+	void write_bytes(const uint8_t* buf, uint16_t count, bool power = 0);
+	uint8_t read(void);
+	void read_bytes(uint8_t* buf, uint16_t count);
+	void write_bit(uint8_t v);
+	uint8_t read_bit(void);
+	void depower(void) {}
+	void reset_search();
+	bool search(uint8_t* newAddr, bool search_mode = true);
+	static uint8_t crc8(const uint8_t* addr, uint8_t len);
+private:
+	uint8_t pin;
+	uint8_t ROM_NO[8];
+	uint8_t LastDiscrepancy;
+	uint8_t LastFamilyDiscrepancy;
+	bool LastDeviceFlag;
+};
@@ -0,0 +1,196 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WString.h"
+#include <cstdio>
+#include <cstdlib>
+#include <cctype>
+#include <strings.h>
+
+static std::string NumberToString(unsigned long long value, const unsigned char& base, const bool& negative)
+{
+    char buf[66];
+    int pos = sizeof(buf) - 1;
+    buf[pos] = 0;
+    unsigned char b = (base < 2) ? 10 : base;
+    do
+    {
+        unsigned int digit = value % b;
+        buf[--pos] = (char)(digit < 10 ? '0' + digit : 'A' + digit - 10);
+        value /= b;
+    } while (value > 0);
+    if (negative)
+    {
+        buf[--pos] = '-';
+    }
+    return std::string(&buf[pos]);
+}
+
+static std::string SignedToString(const long long& value, const unsigned char& base)
+{
+    if (value < 0 && base == DEC)
+    {
+        return NumberToString((unsigned long long)(-(value + 1)) + 1, base, true);
+    }
+    return NumberToString((unsigned long long)value, base, false);
+}
+
+String::String(const char* cstr)
+{
+    if (cstr != NULL)
+    {
+        buffer = cstr;
+    }
+}
+
+String::String(char c) : buffer(1, c) {}
+String::String(unsigned char value, unsigned char base) : buffer(NumberToString(value, base, false)) {}
+String::String(int value, unsigned char base) : buffer(base == DEC ? SignedToString(value, base) : NumberToString((unsigned int)value, base, false)) {}
+String::String(unsigned int value, unsigned char base) : buffer(NumberToString(value, base, false)) {}
+String::String(long value, unsigned char base) : buffer(base == DEC ? SignedToString(value, base) : NumberToString((unsigned long)value, base, false)) {}
+String::String(unsigned long value, unsigned char base) : buffer(NumberToString(value, base, false)) {}
+String::String(long long value, unsigned char base) : buffer(SignedToString(value, base)) {}
+String::String(unsigned long long value, unsigned char base) : buffer(NumberToString(value, base, false)) {}
+String::String(float value, unsigned char decimalPlaces) : String((double)value, decimalPlaces) {}
+
+String::String(double value, unsigned char decimalPlaces)
+{
+    char buf[64];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimalPlaces, value);
+    buffer = buf;
+}
+
+String& String::operator=(const char* cstr)
+{
+    buffer = (cstr != NULL) ? cstr : "";
+    return (*this);
+}
+
+String operator+(const String& lhs, const String& rhs)
+{
+    return String(lhs.buffer + rhs.buffer);
+}
+
+String operator+(const String& lhs, const char* rhs)
+{
+    return String(lhs.buffer + rhs);
+}
+
+String operator+(const char* lhs, const String& rhs)
+{
+    return String(lhs + rhs.buffer);
+}
+
+String operator+(const String& lhs, char rhs)
+{
+    return String(lhs.buffer + rhs);
+}
+
+bool String::equalsIgnoreCase(const String& rhs) const
+{
+    return buffer.length() == rhs.buffer.length() && strcasecmp(buffer.c_str(), rhs.buffer.c_str()) == 0;
+}
+
+int String::indexOf(char ch, unsigned int fromIndex) const
+{
+    size_t pos = buffer.find(ch, fromIndex);
+    return (pos == std::string::npos) ? -1 : (int)pos;
+}
+
+int String::indexOf(const String& str, unsigned int fromIndex) const
+{
+    size_t pos = buffer.find(str.buffer, fromIndex);
+    return (pos == std::string::npos) ? -1 : (int)pos;
+}
+
+int String::indexOf(const char* str, unsigned int fromIndex) const
+{
+    size_t pos = buffer.find(str, fromIndex);
+    return (pos == std::string::npos) ? -1 : (int)pos;
+}
+
+int String::lastIndexOf(char ch) const
+{
+    size_t pos = buffer.rfind(ch);
+    return (pos == std::string::npos) ? -1 : (int)pos;
+}
+
+String String::substring(unsigned int beginIndex) const
+{
+    return substring(beginIndex, length());
+}
+
+String String::substring(unsigned int beginIndex, unsigned int endIndex) const
+{
+    if (beginIndex > endIndex)
+    {
+        unsigned int temp = endIndex;
+        endIndex = beginIndex;
+        beginIndex = temp;
+    }
+    if (beginIndex >= length())
+    {
+        return String();
+    }
+    if (endIndex > length())
+    {
+        endIndex = length();
+    }
+    return String(buffer.substr(beginIndex, endIndex - beginIndex));
+}
+
+void String::replace(const String& find, const String& replace)
+{
+    if (find.buffer.empty())
+    {
+        return;
+    }
+    size_t pos = 0;
+    while ((pos = buffer.find(find.buffer, pos)) != std::string::npos)
+    {
+        buffer.replace(pos, find.buffer.length(), replace.buffer);
+        pos += replace.buffer.length();
+    }
+}
+
+void String::trim()
+{
+    size_t begin = 0;
+    while (begin < buffer.length() && isspace((unsigned char)buffer[begin]))
+    {
+        begin++;
+    }
+    size_t end = buffer.length();
+    while (end > begin && isspace((unsigned char)buffer[end - 1]))
+    {
+        end--;
+    }
+    buffer = buffer.substr(begin, end - begin);
+}
+
+void String::toLowerCase()
+{
+    for (size_t i = 0; i < buffer.length(); i++)
+    {
+        buffer[i] = (char)tolower((unsigned char)buffer[i]);
+    }
+}
+
+long String::toInt() const
+{
+    return atol(buffer.c_str());
+}
+
+float String::toFloat() const
+{
+    return (float)atof(buffer.c_str());
+}
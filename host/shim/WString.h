@@ -0,0 +1,98 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WString.h
+// Minimal Arduino String replacement for the host build, only covers the API used by the firmware sources
+
+#ifndef _WSTRING_h
+#define _WSTRING_h
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+#define F(string_literal) (string_literal)
+
+#ifndef DEC
+	#define DEC 10
+	#define HEX 16
+	#define OCT 8
+	#define BIN 2
+#endif
+
+class String
+{
+public:
+	String(const char* cstr = "");
+	String(const std::string& str) : buffer(str) {}
+	String(const String& str) = default;
+	String(String&& str) = default;
+	explicit String(char c);
+	explicit String(unsigned char value, unsigned char base = DEC);
+	explicit String(int value, unsigned char base = DEC);
+	explicit String(unsigned int value, unsigned char base = DEC);
+	explicit String(long value, unsigned char base = DEC);
+	explicit String(unsigned long value, unsigned char base = DEC);
+	explicit String(long long value, unsigned char base = DEC);
+	explicit String(unsigned long long value, unsigned char base = DEC);
+	explicit String(float value, unsigned char decimalPlaces = 2);
+	explicit String(double value, unsigned char decimalPlaces = 2);
+
+	String& operator=(const String& rhs) = default;
+	String& operator=(String&& rhs) = default;
+	String& operator=(const char* cstr);
+
+	unsigned int length() const { return (unsigned int)buffer.length(); }
+	const char* c_str() const { return buffer.c_str(); }
+	bool reserve(unsigned int size) { buffer.reserve(size); return true; }
+
+	bool concat(const String& str) { buffer += str.buffer; return true; }
+	bool concat(const char* cstr) { buffer += cstr; return true; }
+	bool concat(char c) { buffer += c; return true; }
+	String& operator+=(const String& rhs) { concat(rhs); return (*this); }
+	String& operator+=(const char* cstr) { concat(cstr); return (*this); }
+	String& operator+=(char c) { concat(c); return (*this); }
+
+	friend String operator+(const String& lhs, const String& rhs);
+	friend String operator+(const String& lhs, const char* rhs);
+	friend String operator+(const char* lhs, const String& rhs);
+	friend String operator+(const String& lhs, char rhs);
+
+	bool operator==(const String& rhs) const { return buffer == rhs.buffer; }
+	bool operator==(const char* cstr) const { return buffer == cstr; }
+	bool operator!=(const String& rhs) const { return buffer != rhs.buffer; }
+	bool operator!=(const char* cstr) const { return buffer != cstr; }
+	bool equals(const String& rhs) const { return buffer == rhs.buffer; }
+	bool equalsIgnoreCase(const String& rhs) const;
+	bool startsWith(const String& prefix) const { return buffer.compare(0, prefix.buffer.length(), prefix.buffer) == 0; }
+
+	char charAt(unsigned int index) const { return index < buffer.length() ? buffer[index] : 0; }
+	char operator[](unsigned int index) const { return charAt(index); }
+
+	int indexOf(char ch, unsigned int fromIndex = 0) const;
+	int indexOf(const String& str, unsigned int fromIndex = 0) const;
+	int indexOf(const char* str, unsigned int fromIndex = 0) const;
+	int lastIndexOf(char ch) const;
+	String substring(unsigned int beginIndex) const;
+	String substring(unsigned int beginIndex, unsigned int endIndex) const;
+
+	void replace(const String& find, const String& replace);
+	void trim();
+	void toLowerCase();
+	long toInt() const;
+	float toFloat() const;
+
+private:
+	std::string buffer;
+};
+
+#endif
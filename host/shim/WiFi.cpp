@@ -0,0 +1,97 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+#include "WiFi.h"
+#include <cstdio>
+
+WiFiClass WiFi;
+
+std::vector<String> HostDns::hosts;
+std::vector<IPAddress> HostDns::addresses;
+uint32_t HostDns::latencyMs = HOST_DNS_LATENCY_MS;
+bool HostDns::failure = false;
+uint32_t HostDns::lookupCount = 0;
+
+bool IPAddress::fromString(const char* text)
+{
+    unsigned int octets[4];
+    char tail;
+    if (sscanf(text, "%u.%u.%u.%u%c", &octets[0], &octets[1], &octets[2], &octets[3], &tail) != 4)
+    {
+        return false;
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        if (octets[i] > 255)
+        {
+            return false;
+        }
+    }
+    address = (uint32_t)octets[0] | ((uint32_t)octets[1] << 8) | ((uint32_t)octets[2] << 16) | ((uint32_t)octets[3] << 24);
+    return true;
+}
+
+String IPAddress::toString() const
+{
+    char text[16];
+    snprintf(text, sizeof(text), "%u.%u.%u.%u", (*this)[0], (*this)[1], (*this)[2], (*this)[3]);
+    return String(text);
+}
+
+void HostDns::SetAddress(const String& host, const IPAddress& address)
+{
+    for (size_t i = 0; i < hosts.size(); i++)
+    {
+        if (hosts[i] == host)
+        {
+            addresses[i] = address;
+            return;
+        }
+    }
+    hosts.push_back(host);
+    addresses.push_back(address);
+}
+
+void HostDns::Reset()
+{
+    hosts.clear();
+    addresses.clear();
+    latencyMs = HOST_DNS_LATENCY_MS;
+    failure = false;
+    lookupCount = 0;
+}
+
+int WiFiClass::hostByName(const char* aHostname, IPAddress& aResult)
+{
+    if (aResult.fromString(aHostname))
+    {
+        return 1;
+    }
+    HostDns::lookupCount++;
+    HostHal::AdvanceMillis(HostDns::latencyMs);
+    if (HostDns::failure)
+    {
+        aResult = IPAddress();
+        return 0;
+    }
+    for (size_t i = 0; i < HostDns::hosts.size(); i++)
+    {
+        if (HostDns::hosts[i] == aHostname)
+        {
+            aResult = HostDns::addresses[i];
+            return 1;
+        }
+    }
+    //Names that are not scripted resolve to the documentation network
+    aResult = IPAddress(192, 0, 2, 1);
+    return 1;
+}
@@ -0,0 +1,46 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// WiFi.h
+// Host stand-in for the WiFi class of the ESP32 Arduino core, only the name resolution. Names are resolved
+// by HostDns, which answers scripted addresses (192.0.2.1 for other names) after a latency on the virtual clock, or fails.
+
+#pragma once
+#include "arduino.h"
+#include <vector>
+
+#define HOST_DNS_LATENCY_MS 180 //Query and answer over WiFi
+
+class HostDns
+{
+public:
+	static void SetAddress(const String& host, const IPAddress& address);
+	static void SetLatency(const uint32_t& latencyMs) { HostDns::latencyMs = latencyMs; }
+	static void SetFailure(const bool& fail) { failure = fail; }
+	static uint32_t GetLookupCount() { return lookupCount; }
+	static void Reset();
+private:
+	friend class WiFiClass;
+	static std::vector<String> hosts;
+	static std::vector<IPAddress> addresses;
+	static uint32_t latencyMs;
+	static bool failure;
+	static uint32_t lookupCount;
+};
+
+class WiFiClass
+{
+public:
+	int hostByName(const char* aHostname, IPAddress& aResult);
+};
+
+extern WiFiClass WiFi;
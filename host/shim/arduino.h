@@ -0,0 +1,112 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// arduino.h
+// Host replacement for the ESP32 Arduino core, maps the core API on the virtual hardware of HostHal.h
+
+#ifndef _ARDUINO_HOST_h
+#define _ARDUINO_HOST_h
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/types.h>
+#include <functional>
+#include <algorithm>
+#include "WString.h"
+#include "IPAddress.h"
+#include "HostHal.h"
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define A0 36
+
+#define IRAM_ATTR
+#define DRAM_ATTR
+
+#define digitalPinToInterrupt(p) (p)
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+inline unsigned long millis() { return (unsigned long)(HostHal::GetMicros() / 1000); }
+inline unsigned long micros() { return (unsigned long)HostHal::GetMicros(); }
+inline void delay(const uint32_t ms) { HostHal::AdvanceMillis(ms); }
+inline void delayMicroseconds(const uint32_t us) { HostHal::AdvanceMicros(us); }
+
+inline void pinMode(uint8_t pin, uint8_t mode) { (void)pin; (void)mode; }
+inline uint16_t analogRead(uint8_t pin) { return HostHal::GetAnalogValue(pin); }
+
+inline void noInterrupts() { HostHal::SetInterruptsEnabled(false); }
+inline void interrupts() { HostHal::SetInterruptsEnabled(true); }
+
+inline void attachInterrupt(uint8_t pin, std::function<void(void)> intRoutine, int mode) { HostHal::AttachInterrupt(pin, intRoutine, mode); }
+inline void attachInterrupt(uint8_t pin, void (*intRoutine)(void), int mode) { HostHal::AttachInterrupt(pin, intRoutine, mode); }
+inline void attachInterruptArg(uint8_t pin, void (*intRoutine)(void*), void* arg, int mode) { HostHal::AttachInterrupt(pin, std::bind(intRoutine, arg), mode); }
+inline void detachInterrupt(uint8_t pin) { HostHal::DetachInterrupt(pin); }
+
+class HardwareSerial
+{
+public:
+	void begin(unsigned long baud) { (void)baud; }
+	void print(const String& s);
+	void print(const char* s) { print(String(s)); }
+	template <typename T> void print(const T& v) { print(String(v)); }
+	void println(const String& s) { print(s); print("\n"); }
+	void println(const char* s) { println(String(s)); }
+	template <typename T> void println(const T& v) { println(String(v)); }
+	void println() { print("\n"); }
+};
+
+extern HardwareSerial Serial;
+
+//Read side of the Arduino Stream, what a WiFiClient offers to code that reads a response
+class Stream
+{
+public:
+	virtual ~Stream() {}
+	virtual int available() = 0;
+	virtual int read() = 0;
+	virtual size_t readBytes(uint8_t* buffer, size_t length)
+	{
+		size_t count = 0;
+		int c;
+		while (count < length && (c = read()) >= 0)
+		{
+			buffer[count++] = (uint8_t)c;
+		}
+		return count;
+	}
+	size_t readBytes(char* buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+};
+
+//Free heap of a station with HOST_HEAP_SIZE bytes of heap, less what the host process allocated since the first call
+#define HOST_HEAP_SIZE 180000
+
+class EspClass
+{
+public:
+	uint32_t getFreeHeap();
+	uint32_t getMaxAllocHeap() { return getFreeHeap(); }
+	void restart() {}
+};
+
+extern EspClass ESP;
+
+#endif
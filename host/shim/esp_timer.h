@@ -0,0 +1,20 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// esp_timer.h
+// Host stand-in for the ESP-IDF high resolution timer, reads the virtual clock
+
+#pragma once
+#include <stdint.h>
+#include "HostHal.h"
+
+inline int64_t esp_timer_get_time() { return (int64_t)HostHal::GetMicros(); }
@@ -0,0 +1,28 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// freertos/FreeRTOS.h
+// Host stand-in for the FreeRTOS tick types, one tick per millisecond like the Arduino core.
+
+#pragma once
+#include <stdint.h>
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+#define portMAX_DELAY (TickType_t)0xFFFFFFFF
+#define portTICK_PERIOD_MS 1
+#ifndef pdMS_TO_TICKS
+	#define pdMS_TO_TICKS(xTimeInMs) ((TickType_t)(xTimeInMs))
+#endif
+#define pdTRUE 1
+#define pdFALSE 0
@@ -0,0 +1,24 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// freertos/ringbuf.h
+// Host stand-in for the ESP-IDF ring buffer, as far as the RMT receive channels use it.
+// A receive without data waits the full timeout on the virtual clock.
+
+#pragma once
+#include <stddef.h>
+#include "freertos/FreeRTOS.h"
+
+typedef void* RingbufHandle_t;
+
+void* xRingbufferReceive(RingbufHandle_t xRingbuffer, size_t* pxItemSize, TickType_t xTicksToWait);
+void vRingbufferReturnItem(RingbufHandle_t xRingbuffer, void* pvItem);
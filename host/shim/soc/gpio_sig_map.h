@@ -0,0 +1,19 @@
+/*************************************************************************************************************
+*
+* Title			    : FreeAtHome_ESPWeatherStation
+* Description:      : Implements the Busch-Jeager / ABB Free@Home API for a ESP32 based Weather Station.
+* Version		    : v 0.9
+* Last updated      : 2026.10.17
+* Target		    : Host (Linux) build of the sensor pipeline
+* Author            : Roeland Kluit
+* Web               : https://github.com/roelandkluit/Fah_ESPWeatherStation
+* License           : GPL-3.0 license
+*
+**************************************************************************************************************/
+// soc/gpio_sig_map.h
+// GPIO matrix signal numbers of the ESP32 RMT channels
+
+#pragma once
+
+#define RMT_SIG_IN0_IDX 83
+#define RMT_SIG_OUT0_IDX 87